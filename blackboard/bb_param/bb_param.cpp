@@ -86,8 +86,10 @@ Variant BBParam::get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboa
 		}
 		return saved_value;
 	} else {
-		ERR_FAIL_COND_V_MSG(!p_blackboard->has_var(variable), p_default, vformat("BBParam: Blackboard variable \"%s\" doesn't exist.", variable));
-		return p_blackboard->get_var(variable, p_default);
+		// Single lookup: BBParam may be shared between instances, so it doesn't cache the location.
+		const BBVariable *var = p_blackboard->find_var(variable);
+		ERR_FAIL_NULL_V_MSG(var, p_default, vformat("BBParam: Blackboard variable \"%s\" doesn't exist.", variable));
+		return var->get_value();
 	}
 }
 
@@ -103,6 +105,28 @@ void BBParam::_get_property_list(List<PropertyInfo> *p_list) const {
 	}
 }
 
+double BBParam::get_float_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, double p_default) {
+	if (value_source == SAVED_VALUE && saved_value.get_type() != Variant::NIL) {
+		return saved_value;
+	} else if (value_source == BLACKBOARD_VAR && p_blackboard.is_valid()) {
+		const BBVariable *var = p_blackboard->find_var(variable);
+		ERR_FAIL_NULL_V_MSG(var, p_default, vformat("BBParam: Blackboard variable \"%s\" doesn't exist.", variable));
+		return var->get_float();
+	}
+	return get_value(p_scene_root, p_blackboard, p_default);
+}
+
+int64_t BBParam::get_int_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, int64_t p_default) {
+	if (value_source == SAVED_VALUE && saved_value.get_type() != Variant::NIL) {
+		return saved_value;
+	} else if (value_source == BLACKBOARD_VAR && p_blackboard.is_valid()) {
+		const BBVariable *var = p_blackboard->find_var(variable);
+		ERR_FAIL_NULL_V_MSG(var, p_default, vformat("BBParam: Blackboard variable \"%s\" doesn't exist.", variable));
+		return var->get_int();
+	}
+	return get_value(p_scene_root, p_blackboard, p_default);
+}
+
 void BBParam::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_value_source", "value_source"), &BBParam::set_value_source);
 	ClassDB::bind_method(D_METHOD("get_value_source"), &BBParam::get_value_source);
@@ -56,6 +56,7 @@ public:
 
 	void set_saved_value(Variant p_value);
 	Variant get_saved_value();
+	_FORCE_INLINE_ Variant::Type get_saved_value_type() const { return saved_value.get_type(); }
 
 	void set_variable(const StringName &p_variable);
 	StringName get_variable() const { return variable; }
@@ -70,6 +71,10 @@ public:
 	virtual Variant::Type get_variable_expected_type() const { return get_type(); }
 	virtual Variant get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, const Variant &p_default = Variant());
 
+	// * Typed getters for native tasks (used with BBFloat and BBInt params).
+	double get_float_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, double p_default = 0.0);
+	int64_t get_int_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, int64_t p_default = 0);
+
 	BBParam();
 };
 
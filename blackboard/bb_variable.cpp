@@ -13,6 +13,45 @@
 
 #include "../compat/object.h"
 #include "../compat/variant.h"
+#include "../util/limbo_command_buffer.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/object/script_language.h"
+#include "core/variant/variant_internal.h"
+#include "scene/main/node.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/node.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+namespace {
+
+// If p_share_read_only is true, read-only containers are shared instead of copied (see BlackboardPlan::set_share_defaults()).
+Variant _duplicate_value(const Variant &p_value, bool p_share_read_only) {
+	if (!p_share_read_only) {
+		return p_value.duplicate(true);
+	}
+	switch (p_value.get_type()) {
+		case Variant::ARRAY: {
+			if (Array(p_value).is_read_only()) {
+				return p_value;
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			if (Dictionary(p_value).is_read_only()) {
+				return p_value;
+			}
+		} break;
+		default: {
+		} break;
+	}
+	return p_value.duplicate(true);
+}
+
+} // unnamed namespace
 
 void BBVariable::unref() {
 	if (data && data->refcount.unref()) {
@@ -23,26 +62,84 @@ void BBVariable::unref() {
 
 void BBVariable::set_value(const Variant &p_value) {
 	data->value = p_value; // Setting value even when bound as a fallback in case the binding fails.
+	data->lazy_prefetch_root = 0;
 	data->value_changed = true;
+	data->version++;
 
 	if (is_bound()) {
 		Object *obj = OBJECT_DB_GET_INSTANCE(data->bound_object);
 		ERR_FAIL_COND_MSG(!obj, "Blackboard: Failed to get bound object.");
+		LimboCommandBuffer *command_buffer = LimboCommandBuffer::get_active();
+		if (command_buffer) {
+			command_buffer->set_property(obj, data->bound_property, p_value);
+		} else {
 #ifdef LIMBOAI_MODULE
-		bool r_valid;
-		obj->set(data->bound_property, p_value, &r_valid);
-		ERR_FAIL_COND_MSG(!r_valid, vformat("Blackboard: Failed to set bound property `%s` on %s", data->bound_property, obj));
+			bool r_valid = false;
+			if (data->bound_setter && !obj->get_script_instance()) {
+				// Skip property lookup by calling the native setter directly.
+				const Variant *args[1] = { &p_value };
+				Callable::CallError ce;
+				data->bound_setter->call(obj, args, 1, ce);
+				r_valid = ce.error == Callable::CallError::CALL_OK;
+			}
+			if (!r_valid) {
+				obj->set(data->bound_property, p_value, &r_valid);
+			}
+			ERR_FAIL_COND_MSG(!r_valid, vformat("Blackboard: Failed to set bound property `%s` on %s", data->bound_property, obj));
 #elif LIMBOAI_GDEXTENSION
-		obj->set(data->bound_property, p_value);
+			obj->set(data->bound_property, p_value);
 #endif
+		}
+	}
+
+	if (unlikely(!data->observers.is_empty())) {
+		_notify_observers(p_value);
 	}
 }
 
+void BBVariable::_notify_observers(const Variant &p_value) const {
+	// Copy, so that observers can unsubscribe during notification.
+	const Vector<Callable> observers = data->observers;
+	for (int i = 0; i < observers.size(); i++) {
+		if (observers[i].is_valid()) {
+			observers[i].call(p_value);
+		}
+	}
+}
+
+void BBVariable::add_observer(const Callable &p_callable) {
+	ERR_FAIL_COND_MSG(!p_callable.is_valid(), "Blackboard: Observer callable is invalid.");
+	if (data->observers.find(p_callable) == -1) {
+		data->observers.push_back(p_callable);
+	}
+}
+
+void BBVariable::remove_observer(const Callable &p_callable) {
+	data->observers.erase(p_callable);
+}
+
+bool BBVariable::has_observer(const Callable &p_callable) const {
+	return data->observers.find(p_callable) != -1;
+}
+
 Variant BBVariable::get_value() const {
 	if (is_bound()) {
 		Object *obj = OBJECT_DB_GET_INSTANCE(data->bound_object);
 		ERR_FAIL_COND_V_MSG(!obj, data->value, "Blackboard: Failed to get bound object.");
+		LimboCommandBuffer *command_buffer = LimboCommandBuffer::get_active();
+		Variant pending;
+		if (unlikely(command_buffer) && command_buffer->get_property(obj, data->bound_property, pending)) {
+			return pending;
+		}
 #ifdef LIMBOAI_MODULE
+		if (data->bound_getter && !obj->get_script_instance()) {
+			// Skip property lookup by calling the native getter directly.
+			Callable::CallError ce;
+			Variant ret = data->bound_getter->call(obj, nullptr, 0, ce);
+			if (likely(ce.error == Callable::CallError::CALL_OK)) {
+				return ret;
+			}
+		}
 		bool r_valid;
 		Variant ret = obj->get(data->bound_property, &r_valid);
 		ERR_FAIL_COND_V_MSG(!r_valid, data->value, vformat("Blackboard: Failed to get bound property `%s` on %s", data->bound_property, obj));
@@ -51,12 +148,105 @@ Variant BBVariable::get_value() const {
 #endif
 		return ret;
 	}
+	if (unlikely(data->lazy_prefetch_root != 0)) {
+		_resolve_node_path();
+	}
 	return data->value;
 }
 
+void BBVariable::set_lazy_node_path(Object *p_prefetch_root, const NodePath &p_path) {
+	ERR_FAIL_NULL(p_prefetch_root);
+	data->value = p_path;
+	data->lazy_prefetch_root = p_prefetch_root->get_instance_id();
+}
+
+void BBVariable::_resolve_node_path() const {
+	// The prefetch root is looked up by its ObjectID, as it may be freed before the first read.
+	// Once resolved, the Variant keeps track of the node and reads as null after the node is freed.
+	Node *prefetch_root = Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(data->lazy_prefetch_root));
+	data->lazy_prefetch_root = 0;
+	NodePath path = data->value;
+	Node *n = prefetch_root ? prefetch_root->get_node_or_null(path) : nullptr;
+	if (n != nullptr) {
+		data->value = n;
+	} else {
+		ERR_PRINT(vformat("Blackboard: Prefetch failed for NodePath: %s", path));
+		data->value = Variant();
+	}
+}
+
+template <typename T>
+T BBVariable::_get_typed(Variant::Type p_type) const {
+	if (likely(is_stored_as(p_type))) {
+#ifdef LIMBOAI_MODULE
+		return VariantInternalAccessor<T>::get(&data->value);
+#elif LIMBOAI_GDEXTENSION
+		return static_cast<T>(data->value);
+#endif
+	}
+	// Bound or duck-typed value: convert.
+	return static_cast<T>(get_value());
+}
+
+template <typename T>
+void BBVariable::_set_typed(Variant::Type p_type, const T &p_value) {
+	if (unlikely(!is_stored_as(p_type) || !data->observers.is_empty())) {
+		set_value(p_value);
+		return;
+	}
+#ifdef LIMBOAI_MODULE
+	VariantInternalAccessor<T>::set(&data->value, p_value);
+#elif LIMBOAI_GDEXTENSION
+	data->value = p_value;
+#endif
+	data->value_changed = true;
+	data->version++;
+}
+
+double BBVariable::get_float() const {
+	return _get_typed<double>(Variant::FLOAT);
+}
+
+int64_t BBVariable::get_int() const {
+	return _get_typed<int64_t>(Variant::INT);
+}
+
+bool BBVariable::get_bool() const {
+	return _get_typed<bool>(Variant::BOOL);
+}
+
+Vector2 BBVariable::get_vector2() const {
+	return _get_typed<Vector2>(Variant::VECTOR2);
+}
+
+Vector3 BBVariable::get_vector3() const {
+	return _get_typed<Vector3>(Variant::VECTOR3);
+}
+
+void BBVariable::set_float(double p_value) {
+	_set_typed<double>(Variant::FLOAT, p_value);
+}
+
+void BBVariable::set_int(int64_t p_value) {
+	_set_typed<int64_t>(Variant::INT, p_value);
+}
+
+void BBVariable::set_bool(bool p_value) {
+	_set_typed<bool>(Variant::BOOL, p_value);
+}
+
+void BBVariable::set_vector2(const Vector2 &p_value) {
+	_set_typed<Vector2>(Variant::VECTOR2, p_value);
+}
+
+void BBVariable::set_vector3(const Vector3 &p_value) {
+	_set_typed<Vector3>(Variant::VECTOR3, p_value);
+}
+
 void BBVariable::set_type(Variant::Type p_type) {
 	data->type = p_type;
 	data->value = VARIANT_DEFAULT(p_type);
+	data->lazy_prefetch_root = 0;
 }
 
 Variant::Type BBVariable::get_type() const {
@@ -79,19 +269,24 @@ String BBVariable::get_hint_string() const {
 	return data->hint_string;
 }
 
-BBVariable BBVariable::duplicate(bool p_deep) const {
+BBVariable BBVariable::duplicate(bool p_deep, bool p_share_read_only) const {
 	BBVariable var;
 	var.data->hint = data->hint;
 	var.data->hint_string = data->hint_string;
 	var.data->type = data->type;
 	if (p_deep) {
-		var.data->value = data->value.duplicate(p_deep);
+		var.data->value = _duplicate_value(data->value, p_share_read_only);
 	} else {
 		var.data->value = data->value;
 	}
+	var.data->lazy_prefetch_root = data->lazy_prefetch_root;
 	var.data->binding_path = data->binding_path;
 	var.data->bound_object = data->bound_object;
 	var.data->bound_property = data->bound_property;
+#ifdef LIMBOAI_MODULE
+	var.data->bound_getter = data->bound_getter;
+	var.data->bound_setter = data->bound_setter;
+#endif
 	return var;
 }
 
@@ -120,12 +315,64 @@ void BBVariable::bind(Object *p_object, const StringName &p_property) {
 	ERR_FAIL_COND_MSG(!OBJECT_HAS_PROPERTY(p_object, p_property), vformat("Blackboard: Binding failed - %s has no property `%s`.", p_object, p_property));
 	data->bound_object = p_object->get_instance_id();
 	data->bound_property = p_property;
+#ifdef LIMBOAI_MODULE
+	_cache_bound_accessors(p_object);
+#endif
+}
+
+bool BBVariable::reset_to(const BBVariable &p_default, bool p_share_read_only) {
+	if (data->refcount.get() != 1 || is_bound() || data->type != p_default.data->type) {
+		return false;
+	}
+	data->value = _duplicate_value(p_default.data->value, p_share_read_only);
+	data->lazy_prefetch_root = 0;
+	data->value_changed = false;
+	data->version++;
+	data->observers.clear();
+	return true;
 }
 
 void BBVariable::unbind() {
 	data->bound_object = 0;
 	data->bound_property = StringName();
+#ifdef LIMBOAI_MODULE
+	data->bound_getter = nullptr;
+	data->bound_setter = nullptr;
+#endif
+}
+
+#ifdef LIMBOAI_MODULE
+void BBVariable::_cache_bound_accessors(Object *p_object) {
+	data->bound_getter = nullptr;
+	data->bound_setter = nullptr;
+
+	// Script properties and properties without native accessors go through Object::get/set.
+	if (p_object->get_script_instance()) {
+		return;
+	}
+	const StringName class_name = p_object->get_class_name();
+	bool is_native_property = false;
+	int index = ClassDB::get_property_index(class_name, data->bound_property, &is_native_property);
+	if (!is_native_property || index != -1) {
+		return;
+	}
+
+	StringName getter = ClassDB::get_property_getter(class_name, data->bound_property);
+	if (getter != StringName()) {
+		MethodBind *mb = ClassDB::get_method(class_name, getter);
+		if (mb && mb->get_argument_count() == 0) {
+			data->bound_getter = mb;
+		}
+	}
+	StringName setter = ClassDB::get_property_setter(class_name, data->bound_property);
+	if (setter != StringName()) {
+		MethodBind *mb = ClassDB::get_method(class_name, setter);
+		if (mb && mb->get_argument_count() == 1) {
+			data->bound_setter = mb;
+		}
+	}
 }
+#endif // LIMBOAI_MODULE
 
 bool BBVariable::operator==(const BBVariable &p_var) const {
 	if (data == p_var.data) {
@@ -14,6 +14,8 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
+
+class MethodBind;
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
@@ -22,6 +24,8 @@
 #endif // DEV_ENABLED
 #include <godot_cpp/core/defs.hpp>
 #include <godot_cpp/templates/safe_refcount.hpp>
+#include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/callable.hpp>
 #include <godot_cpp/variant/variant.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
@@ -32,19 +36,41 @@ private:
 		// Is used to decide if the value needs to be synced in a derived plan.
 		bool value_changed = false;
 
+		// Incremented on every assignment, so observers can detect changes without comparing values.
+		uint32_t version = 0;
+		Vector<Callable> observers;
+
 		SafeRefCount refcount;
 		Variant value;
 		Variant::Type type = Variant::NIL;
 		PropertyHint hint = PropertyHint::PROPERTY_HINT_NONE;
 		String hint_string;
 
+		// Node that the stored NodePath is resolved against on first read. Zero if there is nothing to resolve.
+		uint64_t lazy_prefetch_root = 0;
+
 		NodePath binding_path;
 		uint64_t bound_object = 0;
 		StringName bound_property;
+#ifdef LIMBOAI_MODULE
+		// Accessors of the bound native property, resolved once in bind(). Null if not applicable.
+		MethodBind *bound_getter = nullptr;
+		MethodBind *bound_setter = nullptr;
+#endif
 	};
 
 	Data *data = nullptr;
 	void unref();
+	void _notify_observers(const Variant &p_value) const;
+	void _resolve_node_path() const;
+#ifdef LIMBOAI_MODULE
+	void _cache_bound_accessors(Object *p_object);
+#endif
+
+	template <typename T>
+	T _get_typed(Variant::Type p_type) const;
+	template <typename T>
+	void _set_typed(Variant::Type p_type, const T &p_value);
 
 public:
 	void set_value(const Variant &p_value);
@@ -53,13 +79,50 @@ public:
 	void set_type(Variant::Type p_type);
 	Variant::Type get_type() const;
 
+	// Returns true if the value is stored directly (not bound) and has the type p_type.
+	_FORCE_INLINE_ bool is_stored_as(Variant::Type p_type) const { return data->bound_object == 0 && data->value.get_type() == p_type; }
+
+	// * Typed accessors: when the stored value has the matching type, they avoid constructing and copying Variants.
+	double get_float() const;
+	int64_t get_int() const;
+	bool get_bool() const;
+	Vector2 get_vector2() const;
+	Vector3 get_vector3() const;
+
+	void set_float(double p_value);
+	void set_int(int64_t p_value);
+	void set_bool(bool p_value);
+	void set_vector2(const Vector2 &p_value);
+	void set_vector3(const Vector3 &p_value);
+
 	void set_hint(PropertyHint p_hint);
 	PropertyHint get_hint() const;
 
 	void set_hint_string(const String &p_hint_string);
 	String get_hint_string() const;
 
-	BBVariable duplicate(bool p_deep = false) const;
+	// With p_share_read_only, a deep duplicate keeps read-only Array and Dictionary values shared.
+	BBVariable duplicate(bool p_deep = false, bool p_share_read_only = false) const;
+
+	// Restores the value of p_default in place, keeping this variable's storage.
+	// Fails if the storage is shared with another scope or bound to a property.
+	bool reset_to(const BBVariable &p_default, bool p_share_read_only = false);
+
+	_FORCE_INLINE_ uint32_t get_version() const { return data->version; }
+	_FORCE_INLINE_ bool is_same(const BBVariable &p_var) const { return data == p_var.data; }
+
+	// Stores p_path, which is replaced with the node it points to when the value is read for the first time.
+	void set_lazy_node_path(Object *p_prefetch_root, const NodePath &p_path);
+	_FORCE_INLINE_ bool is_node_path_pending() const { return data->lazy_prefetch_root != 0; }
+	_FORCE_INLINE_ void resolve_node_path() const {
+		if (is_node_path_pending()) {
+			_resolve_node_path();
+		}
+	}
+
+	void add_observer(const Callable &p_callable);
+	void remove_observer(const Callable &p_callable);
+	bool has_observer(const Callable &p_callable) const;
 
 	_FORCE_INLINE_ bool is_value_changed() const { return data->value_changed; }
 	_FORCE_INLINE_ void reset_value_changed() { data->value_changed = false; }
@@ -74,6 +137,10 @@ public:
 
 	// * Runtime binding methods
 	_FORCE_INLINE_ bool is_bound() const { return data->bound_object != 0; }
+#ifdef LIMBOAI_MODULE
+	// Returns true if the bound property is accessed through cached MethodBinds.
+	_FORCE_INLINE_ bool has_cached_accessors() const { return data->bound_getter != nullptr || data->bound_setter != nullptr; }
+#endif
 	void bind(Object *p_object, const StringName &p_property);
 	void unbind();
 
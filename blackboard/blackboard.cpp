@@ -10,6 +10,7 @@
  */
 
 #include "blackboard.h"
+#include "../compat/limbo_compat.h"
 #include "../compat/print.h"
 
 #ifdef LIMBOAI_MODULE
@@ -22,6 +23,8 @@
 #include <godot_cpp/core/class_db.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
+SafeNumeric<uint64_t> Blackboard::layout_counter;
+
 bool Blackboard::_set(const StringName &p_name, const Variant &p_value) {
 	String name_str = p_name;
 	if (!name_str.begins_with("scope_")) {
@@ -44,6 +47,7 @@ bool Blackboard::_set(const StringName &p_name, const Variant &p_value) {
 	}
 
 	bb->data[var_name].set_value(p_value);
+	bb->version.increment();
 	return true;
 }
 
@@ -122,35 +126,261 @@ Ref<Blackboard> Blackboard::top() const {
 }
 
 Variant Blackboard::get_var(const StringName &p_name, const Variant &p_default, bool p_complain) const {
-	if (data.has(p_name)) {
-		return data.get(p_name).get_value();
-	} else if (parent.is_valid()) {
-		return parent->get_var(p_name, p_default, p_complain);
-	} else {
-		if (p_complain) {
-			ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
-		}
-		return p_default;
+	const BBVariable *var = find_var(p_name);
+	if (var) {
+		return var->get_value();
+	}
+	if (p_complain) {
+		ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
 	}
+	return p_default;
 }
 
 void Blackboard::set_var(const StringName &p_name, const Variant &p_value) {
-	if (data.has(p_name)) {
+	HashMap<StringName, BBVariable>::Iterator E = data.find(p_name);
+	if (E) {
 		// Not checking type - allowing duck-typing.
-		data[p_name].set_value(p_value);
+		E->value.set_value(p_value);
 	} else {
 		BBVariable var(p_value.get_type());
 		var.set_value(p_value);
 		data.insert(p_name, var);
+		_layout_changed();
 	}
+	version.increment();
 }
 
 bool Blackboard::has_var(const StringName &p_name) const {
-	return data.has(p_name) || (parent.is_valid() && parent->has_var(p_name));
+	return find_var(p_name) != nullptr;
+}
+
+// Returns true if this scope or any of its parents has variables bound to object properties.
+bool Blackboard::has_bound_vars() const {
+	for (const Blackboard *scope = this; scope != nullptr; scope = scope->parent.ptr()) {
+		for (const KeyValue<StringName, BBVariable> &kv : scope->data) {
+			if (kv.value.is_bound()) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+// Resolves lazily prefetched node paths in this scope and its parents.
+// Must be called on the main thread, as it accesses the scene tree.
+void Blackboard::resolve_node_paths() const {
+	for (const Blackboard *scope = this; scope != nullptr; scope = scope->parent.ptr()) {
+		for (const KeyValue<StringName, BBVariable> &kv : scope->data) {
+			kv.value.resolve_node_path();
+		}
+	}
 }
 
 void Blackboard::erase_var(const StringName &p_name) {
-	data.erase(p_name);
+	_forget_link(p_name);
+	if (data.erase(p_name)) {
+		version.increment();
+		_layout_changed();
+	}
+}
+
+// Returns the variable from the closest scope that defines it, or nullptr.
+// The pointer is valid until variables are added to or erased from that scope.
+const BBVariable *Blackboard::find_var(const StringName &p_name) const {
+	HashMap<StringName, BBVariable>::ConstIterator E = data.find(p_name);
+	if (E) {
+		return &E->value;
+	}
+	if (parent.is_null()) {
+		return nullptr;
+	}
+
+	// Variables found in parent scopes are cached, so that repeated lookups don't probe every parent scope.
+	// Cached handles are valid until a variable is added or erased anywhere in the chain.
+	parent_cache_lock.lock();
+	const VarHandle *handle = parent_cache.getptr(p_name);
+	if (handle && handle->layout_stamp == parent->get_layout_stamp()) {
+		const BBVariable *var = handle->var;
+		parent_cache_lock.unlock();
+		return var;
+	}
+	parent_cache_lock.unlock();
+
+	BBVariable *var = nullptr;
+	int depth = 0;
+	for (Blackboard *bb = parent.ptr(); bb; bb = bb->parent.ptr()) {
+		HashMap<StringName, BBVariable>::Iterator P = bb->data.find(p_name);
+		if (P) {
+			var = &P->value;
+			break;
+		}
+		depth++;
+	}
+
+	// Worker threads only read the cache.
+	if (IS_MAIN_THREAD()) {
+		parent_cache_lock.lock();
+		if (var == nullptr) {
+			parent_cache.erase(p_name);
+		} else if (parent_cache.has(p_name) || parent_cache.size() < PARENT_CACHE_MAX_SIZE) {
+			VarHandle &entry = parent_cache[p_name];
+			entry.name = p_name;
+			entry.var = var;
+			entry.depth = depth;
+			entry.resolved_in = parent.ptr();
+			entry.layout_stamp = parent->get_layout_stamp();
+		}
+		parent_cache_lock.unlock();
+	}
+	return var;
+}
+
+uint64_t Blackboard::get_layout_stamp() const {
+	uint64_t stamp = layout_version.get();
+	for (const Blackboard *bb = parent.ptr(); bb; bb = bb->parent.ptr()) {
+		stamp = MAX(stamp, bb->layout_version.get());
+	}
+	return stamp;
+}
+
+// Returns the variable from the closest scope that defines it, or nullptr.
+// The lookup is skipped if r_handle was resolved for this name and the scope chain layout hasn't changed since.
+BBVariable *Blackboard::resolve_var(const StringName &p_name, VarHandle &r_handle) {
+	const uint64_t stamp = get_layout_stamp();
+	if (likely(r_handle.resolved_in == this && r_handle.layout_stamp == stamp && r_handle.name == p_name)) {
+		return r_handle.var;
+	}
+
+	r_handle.name = p_name;
+	r_handle.var = nullptr;
+	r_handle.depth = -1;
+	r_handle.resolved_in = this;
+	r_handle.layout_stamp = stamp;
+
+	Blackboard *bb = this;
+	int depth = 0;
+	while (bb) {
+		HashMap<StringName, BBVariable>::Iterator E = bb->data.find(p_name);
+		if (E) {
+			r_handle.var = &E->value;
+			r_handle.depth = depth;
+			break;
+		}
+		bb = bb->parent.ptr();
+		depth++;
+	}
+	return r_handle.var;
+}
+
+// Same as set_var(), but skips the lookup using r_handle.
+void Blackboard::set_var_with_handle(const StringName &p_name, const Variant &p_value, VarHandle &r_handle) {
+	BBVariable *var = resolve_var(p_name, r_handle);
+	if (var && r_handle.depth == 0) {
+		var->set_value(p_value);
+		version.increment();
+	} else {
+		// Variables are created in the local scope.
+		set_var(p_name, p_value);
+	}
+}
+
+// Same as set_var_with_handle(), but writes the float in place if the variable stores one.
+void Blackboard::set_float_with_handle(const StringName &p_name, double p_value, VarHandle &r_handle) {
+	BBVariable *var = resolve_var(p_name, r_handle);
+	if (var && r_handle.depth == 0) {
+		var->set_float(p_value);
+		version.increment();
+	} else {
+		set_var(p_name, p_value);
+	}
+}
+
+// Returns the variable if it exists and its value can be converted to p_type; otherwise, reports an error.
+const BBVariable *Blackboard::_find_typed_var(const StringName &p_name, Variant::Type p_type) const {
+	const BBVariable *var = find_var(p_name);
+	ERR_FAIL_NULL_V_MSG(var, nullptr, vformat("Blackboard: Variable \"%s\" not found.", p_name));
+	if (unlikely(!var->is_stored_as(p_type))) {
+		// Bound values are checked by their declared type, so that the property getter isn't called twice.
+		const Variant::Type type = var->is_bound() ? var->get_type() : var->get_value().get_type();
+		ERR_FAIL_COND_V_MSG(!Variant::can_convert(type, p_type), nullptr,
+				vformat("Blackboard: Variable \"%s\" of type %s can't be read as %s.", p_name, Variant::get_type_name(type), Variant::get_type_name(p_type)));
+	}
+	return var;
+}
+
+double Blackboard::get_float(const StringName &p_name, double p_default) const {
+	const BBVariable *var = _find_typed_var(p_name, Variant::FLOAT);
+	return var ? var->get_float() : p_default;
+}
+
+int64_t Blackboard::get_int(const StringName &p_name, int64_t p_default) const {
+	const BBVariable *var = _find_typed_var(p_name, Variant::INT);
+	return var ? var->get_int() : p_default;
+}
+
+bool Blackboard::get_bool(const StringName &p_name, bool p_default) const {
+	const BBVariable *var = _find_typed_var(p_name, Variant::BOOL);
+	return var ? var->get_bool() : p_default;
+}
+
+Vector2 Blackboard::get_vector2(const StringName &p_name, const Vector2 &p_default) const {
+	const BBVariable *var = _find_typed_var(p_name, Variant::VECTOR2);
+	return var ? var->get_vector2() : p_default;
+}
+
+Vector3 Blackboard::get_vector3(const StringName &p_name, const Vector3 &p_default) const {
+	const BBVariable *var = _find_typed_var(p_name, Variant::VECTOR3);
+	return var ? var->get_vector3() : p_default;
+}
+
+void Blackboard::set_float(const StringName &p_name, double p_value) {
+	HashMap<StringName, BBVariable>::Iterator E = data.find(p_name);
+	if (E) {
+		E->value.set_float(p_value);
+		version.increment();
+	} else {
+		set_var(p_name, p_value);
+	}
+}
+
+void Blackboard::set_int(const StringName &p_name, int64_t p_value) {
+	HashMap<StringName, BBVariable>::Iterator E = data.find(p_name);
+	if (E) {
+		E->value.set_int(p_value);
+		version.increment();
+	} else {
+		set_var(p_name, p_value);
+	}
+}
+
+void Blackboard::set_bool(const StringName &p_name, bool p_value) {
+	HashMap<StringName, BBVariable>::Iterator E = data.find(p_name);
+	if (E) {
+		E->value.set_bool(p_value);
+		version.increment();
+	} else {
+		set_var(p_name, p_value);
+	}
+}
+
+void Blackboard::set_vector2(const StringName &p_name, const Vector2 &p_value) {
+	HashMap<StringName, BBVariable>::Iterator E = data.find(p_name);
+	if (E) {
+		E->value.set_vector2(p_value);
+		version.increment();
+	} else {
+		set_var(p_name, p_value);
+	}
+}
+
+void Blackboard::set_vector3(const StringName &p_name, const Vector3 &p_value) {
+	HashMap<StringName, BBVariable>::Iterator E = data.find(p_name);
+	if (E) {
+		E->value.set_vector3(p_value);
+		version.increment();
+	} else {
+		set_var(p_name, p_value);
+	}
 }
 
 TypedArray<StringName> Blackboard::list_vars() const {
@@ -207,20 +437,36 @@ void Blackboard::bind_var_to_property(const StringName &p_name, Object *p_object
 	if (!data.has(p_name)) {
 		if (p_create) {
 			data.insert(p_name, BBVariable());
+			_layout_changed();
 		} else {
 			ERR_FAIL_MSG("Blackboard: Can't bind variable that doesn't exist (var: " + p_name + ").");
 		}
 	}
 	data[p_name].bind(p_object, p_property);
+	version.increment();
 }
 
 void Blackboard::unbind_var(const StringName &p_name) {
 	ERR_FAIL_COND_MSG(!data.has(p_name), "Blackboard: Can't unbind variable that doesn't exist (var: " + p_name + ").");
 	data[p_name].unbind();
+	version.increment();
 }
 
 void Blackboard::assign_var(const StringName &p_name, const BBVariable &p_var) {
+	_forget_link(p_name);
 	data.insert(p_name, p_var);
+	version.increment();
+	_layout_changed();
+}
+
+// Restores a local variable to p_default without reallocating it. Returns false if it has to be replaced instead.
+bool Blackboard::reset_local_var(const StringName &p_name, const BBVariable &p_default, bool p_share_read_only) {
+	BBVariable *var = data.getptr(p_name);
+	if (var == nullptr || !var->reset_to(p_default, p_share_read_only)) {
+		return false;
+	}
+	version.increment();
+	return true;
 }
 
 void Blackboard::link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create) {
@@ -234,6 +480,59 @@ void Blackboard::link_var(const StringName &p_name, const Ref<Blackboard> &p_tar
 	ERR_FAIL_COND_MSG(p_target_blackboard.is_null(), "Blackboard: Can't link variable to target blackboard that is null (var: " + p_name + ").");
 	ERR_FAIL_COND_MSG(!p_target_blackboard->data.has(p_target_var), "Blackboard: Can't link variable to non-existent target (var: " + p_name + ", target: " + p_target_var + ").");
 	data[p_name] = p_target_blackboard->data[p_target_var];
+	version.increment();
+	_layout_changed();
+
+	// Writes through the target blackboard don't change the version of this one,
+	// so variables linked outside of the scope chain are tracked separately.
+	_forget_link(p_name);
+	for (const Blackboard *bb = this; bb; bb = bb->parent.ptr()) {
+		if (bb == p_target_blackboard.ptr()) {
+			return;
+		}
+	}
+	linked_vars.push_back({ p_name, data[p_name] });
+}
+
+void Blackboard::_forget_link(const StringName &p_name) {
+	for (uint32_t i = 0; i < linked_vars.size(); i++) {
+		if (linked_vars[i].name == p_name) {
+			linked_vars.remove_at_unordered(i);
+			return;
+		}
+	}
+}
+
+// Returns the sum of versions of variables linked to blackboards outside of the scope chain.
+// Together with get_version(), it changes whenever a variable visible in this scope is set.
+uint32_t Blackboard::get_linked_version() const {
+	uint32_t linked_version = 0;
+	for (const LinkedVar &linked : linked_vars) {
+		linked_version += linked.var.get_version();
+	}
+	return linked_version;
+}
+
+int64_t Blackboard::get_var_version(const StringName &p_name) const {
+	const BBVariable *var = find_var(p_name);
+	ERR_FAIL_NULL_V_MSG(var, -1, "Blackboard: Variable \"" + p_name + "\" not found.");
+	return var->get_version();
+}
+
+void Blackboard::add_var_observer(const StringName &p_name, const Callable &p_callable) {
+	const BBVariable *var = find_var(p_name);
+	ERR_FAIL_NULL_MSG(var, "Blackboard: Can't observe variable that doesn't exist (var: " + p_name + ").");
+	// Copies share the variable data, including its observers.
+	BBVariable shared_var = *var;
+	shared_var.add_observer(p_callable);
+}
+
+void Blackboard::remove_var_observer(const StringName &p_name, const Callable &p_callable) {
+	const BBVariable *var = find_var(p_name);
+	if (var) {
+		BBVariable shared_var = *var;
+		shared_var.remove_observer(p_callable);
+	}
 }
 
 void Blackboard::_bind_methods() {
@@ -252,4 +551,7 @@ void Blackboard::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bind_var_to_property", "var_name", "object", "property", "create"), &Blackboard::bind_var_to_property, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("unbind_var", "var_name"), &Blackboard::unbind_var);
 	ClassDB::bind_method(D_METHOD("link_var", "var_name", "target_blackboard", "target_var", "create"), &Blackboard::link_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_var_version", "var_name"), &Blackboard::get_var_version);
+	ClassDB::bind_method(D_METHOD("add_var_observer", "var_name", "callable"), &Blackboard::add_var_observer);
+	ClassDB::bind_method(D_METHOD("remove_var_observer", "var_name", "callable"), &Blackboard::remove_var_observer);
 }
@@ -17,6 +17,9 @@
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/typed_array.h"
 #include "core/variant/variant.h"
 #endif // LIMBOAI_MODULE
@@ -26,6 +29,9 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
+#include <godot_cpp/templates/spin_lock.hpp>
 #include <godot_cpp/variant/typed_array.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
@@ -33,9 +39,45 @@ using namespace godot;
 class Blackboard : public RefCounted {
 	GDCLASS(Blackboard, RefCounted);
 
+public:
+	// Location of a variable resolved in the scope chain. Lets tasks skip name lookups
+	// on repeated access; it is re-resolved automatically when the chain layout changes.
+	struct VarHandle {
+		StringName name;
+		BBVariable *var = nullptr;
+		int depth = -1; // Scope depth of the variable: 0 is the local scope.
+		const Blackboard *resolved_in = nullptr;
+		uint64_t layout_stamp = 0;
+	};
+
 private:
+	// Variable linked to another blackboard outside of the scope chain.
+	struct LinkedVar {
+		StringName name;
+		BBVariable var;
+	};
+
 	HashMap<StringName, BBVariable> data;
 	Ref<Blackboard> parent;
+	LocalVector<LinkedVar> linked_vars;
+	// Variables found in parent scopes. Filled only on the main thread, and only with names that exist.
+	mutable HashMap<StringName, VarHandle> parent_cache;
+	// Guards parent_cache, as scopes shared between instances may be read from several threads.
+	mutable SpinLock parent_cache_lock;
+	static constexpr uint32_t PARENT_CACHE_MAX_SIZE = 64;
+
+	// Incremented whenever a variable is set, added, erased or relinked in this scope.
+	// Atomic, since thread-safe instances write to their scopes on worker threads.
+	SafeNumeric<uint32_t> version;
+
+	// Changes when variables are added, erased or relinked, or when the parent changes.
+	// Values are drawn from a global counter, so the highest value in a chain identifies its layout.
+	SafeNumeric<uint64_t> layout_version;
+	static SafeNumeric<uint64_t> layout_counter;
+
+	_FORCE_INLINE_ void _layout_changed() { layout_version.set(layout_counter.increment()); }
+	void _forget_link(const StringName &p_name);
+	const BBVariable *_find_typed_var(const StringName &p_name, Variant::Type p_type) const;
 
 protected:
 	static void _bind_methods();
@@ -52,9 +94,18 @@ public:
 	void set_parent(const Ref<Blackboard> &p_blackboard) {
 		ERR_FAIL_COND_MSG(p_blackboard == this, "Blackboard: Can't set parent to itself.");
 		parent = p_blackboard;
+		parent_cache_lock.lock();
+		parent_cache.clear();
+		parent_cache_lock.unlock();
+		version.increment();
+		_layout_changed();
 	}
 	Ref<Blackboard> get_parent() const { return parent; }
 
+	_FORCE_INLINE_ uint32_t get_version() const { return version.get(); }
+	uint32_t get_linked_version() const;
+	uint64_t get_layout_stamp() const;
+
 	Ref<Blackboard> top() const;
 
 	Variant get_var(const StringName &p_name, const Variant &p_default = Variant(), bool p_complain = true) const;
@@ -62,7 +113,33 @@ public:
 	bool has_var(const StringName &p_name) const;
 	_FORCE_INLINE_ bool has_local_var(const StringName &p_name) const { return data.has(p_name); }
 	void erase_var(const StringName &p_name);
-	void clear() { data.clear(); }
+	const BBVariable *find_var(const StringName &p_name) const;
+	bool has_bound_vars() const;
+	void resolve_node_paths() const;
+
+	BBVariable *resolve_var(const StringName &p_name, VarHandle &r_handle);
+	void set_var_with_handle(const StringName &p_name, const Variant &p_value, VarHandle &r_handle);
+	void set_float_with_handle(const StringName &p_name, double p_value, VarHandle &r_handle);
+
+	// * Typed accessors: avoid Variant copies when the variable stores a value of the matching type.
+	// * Getters report an error and return p_default if the variable is missing or can't be converted to the type.
+	double get_float(const StringName &p_name, double p_default = 0.0) const;
+	int64_t get_int(const StringName &p_name, int64_t p_default = 0) const;
+	bool get_bool(const StringName &p_name, bool p_default = false) const;
+	Vector2 get_vector2(const StringName &p_name, const Vector2 &p_default = Vector2()) const;
+	Vector3 get_vector3(const StringName &p_name, const Vector3 &p_default = Vector3()) const;
+
+	void set_float(const StringName &p_name, double p_value);
+	void set_int(const StringName &p_name, int64_t p_value);
+	void set_bool(const StringName &p_name, bool p_value);
+	void set_vector2(const StringName &p_name, const Vector2 &p_value);
+	void set_vector3(const StringName &p_name, const Vector3 &p_value);
+	void clear() {
+		data.clear();
+		linked_vars.clear();
+		version.increment();
+		_layout_changed();
+	}
 	TypedArray<StringName> list_vars() const;
 	void print_state() const;
 
@@ -73,8 +150,15 @@ public:
 	void unbind_var(const StringName &p_name);
 
 	void assign_var(const StringName &p_name, const BBVariable &p_var);
+	bool reset_local_var(const StringName &p_name, const BBVariable &p_default, bool p_share_read_only = false);
 
 	void link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create = false);
+
+	int64_t get_var_version(const StringName &p_name) const;
+	void add_var_observer(const StringName &p_name, const Callable &p_callable);
+	void remove_var_observer(const StringName &p_name, const Callable &p_callable);
+
+	Blackboard() { _layout_changed(); }
 };
 
 #endif // BLACKBOARD_H
@@ -17,6 +17,7 @@
 #include "../util/limbo_utility.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
 #include "core/object/class_db.h"
 #include "scene/main/node.h"
 #ifdef TOOLS_ENABLED
@@ -26,16 +27,55 @@
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/editor_inspector.hpp>
+#include <godot_cpp/classes/engine.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
+namespace {
+
+void _make_read_only_deep(const Variant &p_value) {
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array arr = p_value;
+		if (arr.is_read_only()) {
+			return;
+		}
+		for (int i = 0; i < arr.size(); i++) {
+			_make_read_only_deep(arr[i]);
+		}
+		arr.make_read_only();
+	} else if (p_value.get_type() == Variant::DICTIONARY) {
+		Dictionary dict = p_value;
+		if (dict.is_read_only()) {
+			return;
+		}
+		Array values = dict.values();
+		for (int i = 0; i < values.size(); i++) {
+			_make_read_only_deep(values[i]);
+		}
+		dict.make_read_only();
+	}
+}
+
+bool _is_read_only_container(const Variant &p_value) {
+	if (p_value.get_type() == Variant::ARRAY) {
+		return Array(p_value).is_read_only();
+	} else if (p_value.get_type() == Variant::DICTIONARY) {
+		return Dictionary(p_value).is_read_only();
+	}
+	return false;
+}
+
+} // unnamed namespace
+
 bool BlackboardPlan::_set(const StringName &p_name, const Variant &p_value) {
 	String name_str = p_name;
+	_invalidate_recipe();
 
 #ifdef TOOLS_ENABLED
 	// * Editor
-	if (var_map.has(p_name)) {
-		BBVariable &var = var_map[p_name];
+	if (var_index.has(p_name)) {
+		BBVariable &var = _get_var_ref(p_name);
 		var.set_value(p_value);
+		_share_default(var);
 		if (base.is_valid() && p_value == base->get_var(p_name).get_value()) {
 			// When user pressed reset property button in inspector...
 			var.reset_value_changed();
@@ -91,19 +131,20 @@ bool BlackboardPlan::_set(const StringName &p_name, const Variant &p_value) {
 	if (name_str.begins_with("var/")) {
 		StringName var_name = name_str.get_slicec('/', 1);
 		String what = name_str.get_slicec('/', 2);
-		if (!var_map.has(var_name) && what == "name") {
+		if (!var_index.has(var_name) && what == "name") {
 			add_var(var_name, BBVariable());
 		}
 		if (what == "name") {
 			// We don't store variable name with the variable.
 		} else if (what == "type") {
-			var_map[var_name].set_type((Variant::Type)(int)p_value);
+			_get_var_ref(var_name).set_type((Variant::Type)(int)p_value);
 		} else if (what == "value") {
-			var_map[var_name].set_value(p_value);
+			_get_var_ref(var_name).set_value(p_value);
+			_share_default(_get_var_ref(var_name));
 		} else if (what == "hint") {
-			var_map[var_name].set_hint((PropertyHint)(int)p_value);
+			_get_var_ref(var_name).set_hint((PropertyHint)(int)p_value);
 		} else if (what == "hint_string") {
-			var_map[var_name].set_hint_string(p_value);
+			_get_var_ref(var_name).set_hint_string(p_value);
 		} else if (what == "property_binding") {
 			property_bindings[var_name] = NodePath(p_value);
 		} else {
@@ -120,7 +161,7 @@ bool BlackboardPlan::_get(const StringName &p_name, Variant &r_ret) const {
 
 #ifdef TOOLS_ENABLED
 	// * Editor
-	if (var_map.has(p_name)) {
+	if (var_index.has(p_name)) {
 		if (has_mapping(p_name)) {
 			r_ret = "Mapped to " + LimboUtility::get_singleton()->decorate_var(parent_scope_mapping[p_name]);
 		} else if (has_property_binding(p_name)) {
@@ -142,7 +183,7 @@ bool BlackboardPlan::_get(const StringName &p_name, Variant &r_ret) const {
 			}
 			r_ret = String::utf8("🔗 ") + shortened_path;
 		} else {
-			r_ret = var_map[p_name].get_value();
+			r_ret = _get_var_ref(p_name).get_value();
 		}
 		return true;
 	}
@@ -182,18 +223,18 @@ bool BlackboardPlan::_get(const StringName &p_name, Variant &r_ret) const {
 	}
 	StringName var_name = name_str.get_slicec('/', 1);
 	String what = name_str.get_slicec('/', 2);
-	ERR_FAIL_COND_V(!var_map.has(var_name), false);
+	ERR_FAIL_COND_V(!var_index.has(var_name), false);
 
 	if (what == "name") {
 		r_ret = var_name;
 	} else if (what == "type") {
-		r_ret = var_map[var_name].get_type();
+		r_ret = _get_var_ref(var_name).get_type();
 	} else if (what == "value") {
-		r_ret = var_map[var_name].get_value();
+		r_ret = _get_var_ref(var_name).get_value();
 	} else if (what == "hint") {
-		r_ret = var_map[var_name].get_hint();
+		r_ret = _get_var_ref(var_name).get_hint();
 	} else if (what == "hint_string") {
-		r_ret = var_map[var_name].get_hint_string();
+		r_ret = _get_var_ref(var_name).get_hint_string();
 	}
 	return true;
 }
@@ -215,7 +256,7 @@ void BlackboardPlan::_get_property_list(List<PropertyInfo> *p_list) const {
 #endif // TOOLS_ENABLED
 
 		// * Storage
-		if (is_derived() && (!var.is_value_changed() || var.get_value() == base->var_map[var_name].get_value())) {
+		if (is_derived() && (!var.is_value_changed() || var.get_value() == base->_get_var_ref(var_name).get_value())) {
 			// Don't store variable if it's not modified in a derived plan.
 			// Variable is considered modified when it's marked as changed and its value is different from the base plan.
 			continue;
@@ -265,7 +306,7 @@ bool BlackboardPlan::_property_can_revert(const StringName &p_name) const {
 	if (String(p_name).begins_with("mapping/")) {
 		return true;
 	}
-	return base.is_valid() && base->var_map.has(p_name);
+	return base.is_valid() && base->var_index.has(p_name);
 }
 
 bool BlackboardPlan::_property_get_revert(const StringName &p_name, Variant &r_property) const {
@@ -273,8 +314,8 @@ bool BlackboardPlan::_property_get_revert(const StringName &p_name, Variant &r_p
 		r_property = StringName();
 		return true;
 	}
-	if (base->var_map.has(p_name)) {
-		r_property = base->var_map[p_name].get_value();
+	if (base->var_index.has(p_name)) {
+		r_property = base->_get_var_ref(p_name).get_value();
 		return true;
 	}
 	return false;
@@ -287,6 +328,7 @@ void BlackboardPlan::set_base_plan(const Ref<BlackboardPlan> &p_base) {
 	} else {
 		base = p_base;
 	}
+	_invalidate_recipe();
 	sync_with_base_plan();
 	notify_property_list_changed();
 }
@@ -319,6 +361,7 @@ bool BlackboardPlan::has_mapping(const StringName &p_name) const {
 
 void BlackboardPlan::set_property_binding(const StringName &p_name, const NodePath &p_path) {
 	property_bindings[p_name] = p_path;
+	_invalidate_recipe();
 	emit_changed();
 }
 
@@ -327,6 +370,50 @@ void BlackboardPlan::set_prefetch_nodepath_vars(bool p_enable) {
 	emit_changed();
 }
 
+void BlackboardPlan::set_lazy_nodepath_prefetch(bool p_enable) {
+	lazy_nodepath_prefetch = p_enable;
+	emit_changed();
+}
+
+// Returns true if populated blackboards access the scene when their variables are read or written,
+// i.e., through bound properties or lazily resolved node paths.
+bool BlackboardPlan::accesses_scene() const {
+	if (prefetch_nodepath_vars && lazy_nodepath_prefetch) {
+		return true;
+	}
+	for (const Pair<StringName, BBVariable> &p : var_list) {
+		if (!get_property_binding(p.first).is_empty() || (is_derived() && !base->get_property_binding(p.first).is_empty())) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void BlackboardPlan::set_share_defaults(bool p_enable) {
+	share_defaults = p_enable;
+	for (Pair<StringName, BBVariable> &p : var_list) {
+		if (share_defaults) {
+			_share_default(p.second);
+		} else if (_is_read_only_container(p.second.get_value())) {
+			// Replace frozen defaults with editable copies. Blackboards populated earlier keep the shared values.
+			bool changed = p.second.is_value_changed();
+			p.second.set_value(p.second.get_value().duplicate(true));
+			if (!changed) {
+				p.second.reset_value_changed();
+			}
+		}
+	}
+	emit_changed();
+}
+
+// Shared defaults are frozen up front, so that populating blackboards only reads them, even on worker threads.
+// In the editor, values stay editable and are duplicated as usual.
+void BlackboardPlan::_share_default(const BBVariable &p_var) const {
+	if (share_defaults && !Engine::get_singleton()->is_editor_hint()) {
+		_make_read_only_deep(p_var.get_value());
+	}
+}
+
 bool BlackboardPlan::is_prefetching_nodepath_vars() const {
 	if (is_derived()) {
 		return base->is_prefetching_nodepath_vars();
@@ -337,30 +424,35 @@ bool BlackboardPlan::is_prefetching_nodepath_vars() const {
 
 void BlackboardPlan::add_var(const StringName &p_name, const BBVariable &p_var) {
 	ERR_FAIL_COND(p_name == StringName());
-	ERR_FAIL_COND(var_map.has(p_name));
-	var_map.insert(p_name, p_var);
+	ERR_FAIL_COND(var_index.has(p_name));
+	var_index.insert(p_name, var_list.size());
 	var_list.push_back(Pair<StringName, BBVariable>(p_name, p_var));
+	_share_default(p_var);
+	_invalidate_recipe();
 	notify_property_list_changed();
 	emit_changed();
 }
 
 void BlackboardPlan::remove_var(const StringName &p_name) {
-	ERR_FAIL_COND(!var_map.has(p_name));
-	var_list.erase(Pair<StringName, BBVariable>(p_name, var_map[p_name]));
-	var_map.erase(p_name);
+	ERR_FAIL_COND(!var_index.has(p_name));
+	uint32_t index = var_index[p_name];
+	var_list.remove_at(index);
+	var_index.erase(p_name);
+	_rebuild_var_index(index);
+	_invalidate_recipe();
 	notify_property_list_changed();
 	emit_changed();
 }
 
 BBVariable BlackboardPlan::get_var(const StringName &p_name) {
-	ERR_FAIL_COND_V(!var_map.has(p_name), BBVariable());
-	return var_map.get(p_name);
+	ERR_FAIL_COND_V(!var_index.has(p_name), BBVariable());
+	return _get_var_ref(p_name);
 }
 
 Pair<StringName, BBVariable> BlackboardPlan::get_var_by_index(int p_index) {
 	Pair<StringName, BBVariable> ret;
-	ERR_FAIL_INDEX_V(p_index, (int)var_map.size(), ret);
-	return var_list.get(p_index);
+	ERR_FAIL_INDEX_V(p_index, (int)var_list.size(), ret);
+	return var_list[p_index];
 }
 
 TypedArray<StringName> BlackboardPlan::list_vars() const {
@@ -385,7 +477,7 @@ bool BlackboardPlan::is_valid_var_name(const StringName &p_name) const {
 	if (name_str.begins_with("resource_")) {
 		return false;
 	}
-	return name_str.is_valid_identifier() && !var_map.has(p_name);
+	return name_str.is_valid_identifier() && !var_index.has(p_name);
 }
 
 void BlackboardPlan::rename_var(const StringName &p_name, const StringName &p_new_name) {
@@ -394,52 +486,48 @@ void BlackboardPlan::rename_var(const StringName &p_name, const StringName &p_ne
 	}
 
 	ERR_FAIL_COND(!is_valid_var_name(p_new_name));
-	ERR_FAIL_COND(!var_map.has(p_name));
-	ERR_FAIL_COND(var_map.has(p_new_name));
-
-	BBVariable var = var_map[p_name];
-	Pair<StringName, BBVariable> new_entry(p_new_name, var);
-	Pair<StringName, BBVariable> old_entry(p_name, var);
-	var_list.find(old_entry)->set(new_entry);
+	ERR_FAIL_COND(!var_index.has(p_name));
+	ERR_FAIL_COND(var_index.has(p_new_name));
 
-	var_map.erase(p_name);
-	var_map.insert(p_new_name, var);
+	uint32_t index = var_index[p_name];
+	var_list[index].first = p_new_name;
+	var_index.erase(p_name);
+	var_index.insert(p_new_name, index);
 
 	if (parent_scope_mapping.has(p_name)) {
 		parent_scope_mapping[p_new_name] = parent_scope_mapping[p_name];
 		parent_scope_mapping.erase(p_name);
 	}
 
+	_invalidate_recipe();
 	notify_property_list_changed();
 	emit_changed();
 }
 
 void BlackboardPlan::move_var(int p_index, int p_new_index) {
-	ERR_FAIL_INDEX(p_index, (int)var_map.size());
-	ERR_FAIL_INDEX(p_new_index, (int)var_map.size());
+	ERR_FAIL_INDEX(p_index, (int)var_list.size());
+	ERR_FAIL_INDEX(p_new_index, (int)var_list.size());
 
 	if (p_index == p_new_index) {
 		return;
 	}
 
-	List<Pair<StringName, BBVariable>>::Element *E = var_list.front();
-	for (int i = 0; i < p_index; i++) {
-		E = E->next();
-	}
-	List<Pair<StringName, BBVariable>>::Element *E2 = var_list.front();
-	for (int i = 0; i < p_new_index; i++) {
-		E2 = E2->next();
-	}
-
-	var_list.move_before(E, E2);
-	if (p_new_index > p_index) {
-		var_list.move_before(E2, E);
-	}
+	Pair<StringName, BBVariable> entry = var_list[p_index];
+	var_list.remove_at(p_index);
+	var_list.insert(p_new_index, entry);
+	_rebuild_var_index(MIN(p_index, p_new_index));
+	_invalidate_recipe();
 
 	notify_property_list_changed();
 	emit_changed();
 }
 
+void BlackboardPlan::_rebuild_var_index(uint32_t p_from) {
+	for (uint32_t i = p_from; i < var_list.size(); i++) {
+		var_index[var_list[i].first] = i;
+	}
+}
+
 void BlackboardPlan::sync_with_base_plan() {
 	if (base.is_null()) {
 		return;
@@ -447,18 +535,24 @@ void BlackboardPlan::sync_with_base_plan() {
 
 	bool changed = false;
 
-	// Sync variables with the base plan.
+	// Sync variables with the base plan, collecting them in the base plan order.
+	// Variables that do not exist in the base plan are left out.
+	LocalVector<Pair<StringName, BBVariable>> synced_list;
+	synced_list.reserve(base->var_list.size());
 	for (const Pair<StringName, BBVariable> &p : base->var_list) {
 		const StringName &base_name = p.first;
 		const BBVariable &base_var = p.second;
 
-		if (!var_map.has(base_name)) {
-			add_var(base_name, base_var.duplicate());
+		const uint32_t *index = var_index.getptr(base_name);
+		if (index == nullptr) {
+			BBVariable var = base_var.duplicate();
+			_share_default(var);
+			synced_list.push_back(Pair<StringName, BBVariable>(base_name, var));
 			changed = true;
 			continue;
 		}
 
-		BBVariable var = var_map[base_name];
+		BBVariable var = var_list[*index].second;
 		if (!var.is_same_prop_info(base_var)) {
 			var.copy_prop_info(base_var);
 			changed = true;
@@ -468,41 +562,20 @@ void BlackboardPlan::sync_with_base_plan() {
 			// Reset value according to base plan.
 			var.set_value(base_var.get_value());
 			var.reset_value_changed();
+			_share_default(var);
 			changed = true;
 		}
+		synced_list.push_back(Pair<StringName, BBVariable>(base_name, var));
 	}
 
-	// Erase variables that do not exist in the base plan.
-	List<StringName> erase_list;
-	for (const Pair<StringName, BBVariable> &p : var_list) {
-		if (!base->has_var(p.first)) {
-			erase_list.push_back(p.first);
-			changed = true;
-		}
-	}
-	while (erase_list.size()) {
-		remove_var(erase_list.front()->get());
-		erase_list.pop_front();
-	}
-
-	// Sync order of variables.
-	// Glossary: E - element of current plan, B - element of base plan, F - element of current plan (used for forward search).
-	ERR_FAIL_COND(base->var_list.size() != var_list.size());
-	List<Pair<StringName, BBVariable>>::Element *B = base->var_list.front();
-	for (List<Pair<StringName, BBVariable>>::Element *E = var_list.front(); E; E = E->next()) {
-		if (E->get().first != B->get().first) {
-			List<Pair<StringName, BBVariable>>::Element *F = E->next();
-			while (F) {
-				if (F->get().first == B->get().first) {
-					var_list.move_before(F, E);
-					E = F;
-					break;
-				}
-				F = F->next();
-			}
-		}
-		B = B->next();
+	if (!changed && synced_list.size() != var_list.size()) {
+		// Some variables were erased.
+		changed = true;
 	}
+	var_list = synced_list;
+	var_index.clear();
+	_rebuild_var_index();
+	_invalidate_recipe();
 
 	if (changed) {
 		notify_property_list_changed();
@@ -518,70 +591,148 @@ Ref<Blackboard> BlackboardPlan::create_blackboard(Node *p_prefetch_root, const R
 	return bb;
 }
 
-void BlackboardPlan::populate_blackboard(const Ref<Blackboard> &p_blackboard, bool overwrite, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan) {
-	ERR_FAIL_COND(p_prefetch_root == nullptr && prefetch_nodepath_vars);
-	ERR_FAIL_COND(p_blackboard.is_null());
+void BlackboardPlan::_compile_recipe() {
+	recipe.clear();
+	recipe.reserve(var_list.size());
 	for (const Pair<StringName, BBVariable> &p : var_list) {
-		if (p_blackboard->has_local_var(p.first) && !overwrite) {
-#ifdef DEBUG_ENABLED
-			Variant::Type existing_type = p_blackboard->get_var(p.first).get_type();
-			Variant::Type planned_type = p.second.get_type();
-			if (existing_type != planned_type && existing_type != Variant::NIL && planned_type != Variant::NIL && !(existing_type == Variant::OBJECT && planned_type == Variant::NODE_PATH)) {
-				WARN_PRINT(vformat("BlackboardPlan: Not overwriting %s as it already exists in the blackboard, but it has a different type than planned (%s vs %s). File: %s",
-						LimboUtility::get_singleton()->decorate_var(p.first), Variant::get_type_name(existing_type), Variant::get_type_name(planned_type), get_path()));
+		PopulateStep step;
+		step.name = p.first;
+		step.var = p.second;
+
+		NodePath binding_path;
+		if (parent_scope_mapping.has(p.first)) {
+			step.kind = PopulateStep::MAPPED;
+			step.mapping_target = parent_scope_mapping[p.first];
+		} else if (has_property_binding(p.first)) {
+			step.kind = PopulateStep::BOUND;
+			binding_path = property_bindings[p.first];
+		} else if (is_derived() && base->has_property_binding(p.first)) {
+			step.kind = PopulateStep::BOUND_IN_BASE_PLAN;
+			binding_path = base->property_bindings[p.first];
+		}
+
+		if (step.kind == PopulateStep::BOUND || step.kind == PopulateStep::BOUND_IN_BASE_PLAN) {
+			if (binding_path.get_subname_count() == 1) {
+				step.binding_node_path = NodePath(binding_path.get_concatenated_names());
+				step.binding_property = binding_path.get_subname(0);
+			} else {
+				step.binding_node_path = binding_path;
 			}
-#endif
-			continue;
 		}
-		bool is_bound = has_property_binding(p.first) || (is_derived() && get_base_plan()->has_property_binding(p.first));
-		bool has_mapping = parent_scope_mapping.has(p.first);
-		bool do_prefetch = !is_bound && !has_mapping && prefetch_nodepath_vars;
+		recipe.push_back(step);
+	}
+	recipe_dirty = false;
+	base_recipe_version = is_derived() ? base->recipe_version : 0;
+}
+
+// Compiles the recipe if the plan or its base plan changed since the last population.
+// The lock only guards the compilation: the plan shouldn't be modified while it's used.
+void BlackboardPlan::_ensure_recipe() {
+	recipe_lock.lock();
+	if (recipe_dirty || (is_derived() && base->recipe_version != base_recipe_version)) {
+		_compile_recipe();
+	}
+	recipe_lock.unlock();
+}
+
+void BlackboardPlan::_populate_step(const Ref<Blackboard> &p_blackboard, const PopulateStep &p_step, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan) {
+	const StringName &name = p_step.name;
+	const BBVariable &plan_var = p_step.var;
 
-		// Add a variable duplicate to the blackboard, optionally with NodePath prefetch.
-		BBVariable var = p.second.duplicate(true);
-		if (unlikely(do_prefetch && p.second.get_type() == Variant::NODE_PATH)) {
-			Node *prefetch_root = !p_prefetch_root_for_base_plan || !is_derived() || is_derived_var_changed(p.first) ? p_prefetch_root : p_prefetch_root_for_base_plan;
-			Node *n = prefetch_root->get_node_or_null(p.second.get_value());
+	// Add a variable duplicate to the blackboard, optionally with NodePath prefetch.
+	BBVariable var = plan_var.duplicate(true, share_defaults);
+	if (unlikely(p_step.kind == PopulateStep::PLAIN && prefetch_nodepath_vars && plan_var.get_type() == Variant::NODE_PATH)) {
+		Node *prefetch_root = !p_prefetch_root_for_base_plan || !is_derived() || is_derived_var_changed(name) ? p_prefetch_root : p_prefetch_root_for_base_plan;
+		if (lazy_nodepath_prefetch) {
+			var.set_lazy_node_path(prefetch_root, plan_var.get_value());
+		} else {
+			Node *n = prefetch_root->get_node_or_null(plan_var.get_value());
 			if (n != nullptr) {
 				var.set_value(n);
 			} else {
-				ERR_PRINT(vformat("BlackboardPlan: Prefetch failed for variable $%s with value: %s", p.first, p.second.get_value()));
+				ERR_PRINT(vformat("BlackboardPlan: Prefetch failed for variable $%s with value: %s", name, plan_var.get_value()));
 				var.set_value(Variant());
 			}
 		}
-		p_blackboard->assign_var(p.first, var);
+	}
+	p_blackboard->assign_var(name, var);
 
-		if (has_mapping) {
-			StringName target_var = parent_scope_mapping[p.first];
-			if (target_var != StringName()) {
-				ERR_CONTINUE_MSG(p_blackboard->get_parent().is_null(), vformat("BlackboardPlan: Cannot link variable %s to parent scope because the parent scope is not set.", LimboUtility::get_singleton()->decorate_var(p.first)));
-				p_blackboard->link_var(p.first, p_blackboard->get_parent(), target_var);
+	switch (p_step.kind) {
+		case PopulateStep::PLAIN: {
+		} break;
+		case PopulateStep::MAPPED: {
+			if (p_step.mapping_target != StringName()) {
+				ERR_FAIL_COND_MSG(p_blackboard->get_parent().is_null(), vformat("BlackboardPlan: Cannot link variable %s to parent scope because the parent scope is not set.", LimboUtility::get_singleton()->decorate_var(name)));
+				p_blackboard->link_var(name, p_blackboard->get_parent(), p_step.mapping_target);
 			}
-		} else if (is_bound) {
+		} break;
+		case PopulateStep::BOUND:
+		case PopulateStep::BOUND_IN_BASE_PLAN: {
 			// Bind variable to a property of a scene node.
-			NodePath binding_path;
-			Node *binding_root;
-			if (has_property_binding(p.first)) {
-				binding_path = property_bindings[p.first];
-				binding_root = p_prefetch_root;
-			} else {
-				binding_path = get_base_plan()->property_bindings[p.first];
-				binding_root = p_prefetch_root_for_base_plan;
-			}
-			ERR_CONTINUE_MSG(binding_path.get_subname_count() != 1, vformat("BlackboardPlan: Can't bind variable %s using property path that contains multiple sub-names: %s", LimboUtility::get_singleton()->decorate_var(p.first), binding_path));
-			NodePath node_path{ binding_path.get_concatenated_names() };
-			StringName prop_name = binding_path.get_subname(0);
+			ERR_FAIL_COND_MSG(p_step.binding_property == StringName(), vformat("BlackboardPlan: Can't bind variable %s using property path that contains multiple sub-names: %s", LimboUtility::get_singleton()->decorate_var(name), p_step.binding_node_path));
 			// TODO: Implement binding for base plan as well.
-			Node *n = binding_root->get_node_or_null(node_path);
-			ERR_CONTINUE_MSG(n == nullptr, vformat("BlackboardPlan: Binding failed for variable %s using property path: %s", LimboUtility::get_singleton()->decorate_var(p.first), binding_path));
-			var.bind(n, prop_name);
+			Node *binding_root = p_step.kind == PopulateStep::BOUND ? p_prefetch_root : p_prefetch_root_for_base_plan;
+			Node *n = binding_root->get_node_or_null(p_step.binding_node_path);
+			ERR_FAIL_COND_MSG(n == nullptr, vformat("BlackboardPlan: Binding failed for variable %s using property path: %s:%s", LimboUtility::get_singleton()->decorate_var(name), p_step.binding_node_path, p_step.binding_property));
+			var.bind(n, p_step.binding_property);
+		} break;
+	}
+}
+
+void BlackboardPlan::populate_blackboard(const Ref<Blackboard> &p_blackboard, bool overwrite, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan) {
+	ERR_FAIL_COND(p_prefetch_root == nullptr && prefetch_nodepath_vars);
+	ERR_FAIL_COND(p_blackboard.is_null());
+	_ensure_recipe();
+	for (const PopulateStep &step : recipe) {
+		if (p_blackboard->has_local_var(step.name) && !overwrite) {
+#ifdef DEBUG_ENABLED
+			Variant::Type existing_type = p_blackboard->get_var(step.name).get_type();
+			Variant::Type planned_type = step.var.get_type();
+			if (existing_type != planned_type && existing_type != Variant::NIL && planned_type != Variant::NIL && !(existing_type == Variant::OBJECT && planned_type == Variant::NODE_PATH)) {
+				WARN_PRINT(vformat("BlackboardPlan: Not overwriting %s as it already exists in the blackboard, but it has a different type than planned (%s vs %s). File: %s",
+						LimboUtility::get_singleton()->decorate_var(step.name), Variant::get_type_name(existing_type), Variant::get_type_name(planned_type), get_path()));
+			}
+#endif
+			continue;
+		}
+		_populate_step(p_blackboard, step, p_prefetch_root, p_prefetch_root_for_base_plan);
+	}
+}
+
+// Restores plan defaults in a blackboard that was populated by this plan before.
+// Plain variables are reset in place; bound, mapped and prefetched ones are populated again.
+// Without a prefetch root, the variables that depend on the scene are left out.
+void BlackboardPlan::reset_blackboard(const Ref<Blackboard> &p_blackboard, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan) {
+	ERR_FAIL_COND(p_blackboard.is_null());
+
+	TypedArray<StringName> local_vars = p_blackboard->list_vars();
+	for (int i = 0; i < local_vars.size(); i++) {
+		StringName var_name = local_vars[i];
+		if (!var_index.has(var_name)) {
+			p_blackboard->erase_var(var_name);
+		}
+	}
+
+	_ensure_recipe();
+	for (const PopulateStep &step : recipe) {
+		bool is_plain = step.kind == PopulateStep::PLAIN && !(prefetch_nodepath_vars && step.var.get_type() == Variant::NODE_PATH);
+		if (is_plain && p_blackboard->reset_local_var(step.name, step.var, share_defaults)) {
+			continue;
+		}
+		if (!is_plain && p_prefetch_root == nullptr) {
+			continue;
 		}
+		_populate_step(p_blackboard, step, p_prefetch_root, p_prefetch_root_for_base_plan);
 	}
 }
 
 void BlackboardPlan::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_prefetch_nodepath_vars", "enable"), &BlackboardPlan::set_prefetch_nodepath_vars);
 	ClassDB::bind_method(D_METHOD("is_prefetching_nodepath_vars"), &BlackboardPlan::is_prefetching_nodepath_vars);
+	ClassDB::bind_method(D_METHOD("set_lazy_nodepath_prefetch", "enable"), &BlackboardPlan::set_lazy_nodepath_prefetch);
+	ClassDB::bind_method(D_METHOD("is_lazy_nodepath_prefetch"), &BlackboardPlan::is_lazy_nodepath_prefetch);
+	ClassDB::bind_method(D_METHOD("set_share_defaults", "enable"), &BlackboardPlan::set_share_defaults);
+	ClassDB::bind_method(D_METHOD("is_sharing_defaults"), &BlackboardPlan::is_sharing_defaults);
 
 	ClassDB::bind_method(D_METHOD("set_base_plan", "blackboard_plan"), &BlackboardPlan::set_base_plan);
 	ClassDB::bind_method(D_METHOD("get_base_plan"), &BlackboardPlan::get_base_plan);
@@ -594,6 +745,8 @@ void BlackboardPlan::_bind_methods() {
 
 	// To avoid cluttering the member namespace, we do not export unnecessary properties in this class.
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "prefetch_nodepath_vars", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_prefetch_nodepath_vars", "is_prefetching_nodepath_vars");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lazy_nodepath_prefetch", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_lazy_nodepath_prefetch", "is_lazy_nodepath_prefetch");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "share_defaults", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_share_defaults", "is_sharing_defaults");
 }
 
 BlackboardPlan::BlackboardPlan() {
@@ -18,10 +18,14 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/io/resource.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/spin_lock.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
@@ -29,8 +33,9 @@ class BlackboardPlan : public Resource {
 	GDCLASS(BlackboardPlan, Resource);
 
 private:
-	List<Pair<StringName, BBVariable>> var_list;
-	HashMap<StringName, BBVariable> var_map;
+	// Variables in their listed order, with a name-to-index table for lookups.
+	LocalVector<Pair<StringName, BBVariable>> var_list;
+	HashMap<StringName, uint32_t> var_index;
 
 	// When base is not null, the plan is considered to be derived from the base plan.
 	// A derived plan can only have variables that exist in the base plan,
@@ -52,10 +57,55 @@ private:
 
 	// If true, NodePath variables will be prefetched, so that the vars will contain node pointers instead (upon BB creation/population).
 	bool prefetch_nodepath_vars = true;
+	// If true, prefetched NodePath variables are resolved on first read instead of upon BB creation/population.
+	bool lazy_nodepath_prefetch = false;
+
+	// If true, Array and Dictionary defaults are made read-only at runtime and shared by all blackboards instead of being duplicated.
+	bool share_defaults = false;
+
+	// Compiled population step of a variable, so that populating a blackboard is a single pass over the plan.
+	struct PopulateStep {
+		enum Kind : uint8_t {
+			PLAIN,
+			MAPPED,
+			BOUND,
+			BOUND_IN_BASE_PLAN,
+		};
+
+		StringName name;
+		BBVariable var;
+		Kind kind = PLAIN;
+		StringName mapping_target;
+		NodePath binding_node_path; // The whole binding path if it's invalid.
+		StringName binding_property; // Empty if the binding path is invalid.
+	};
+
+	LocalVector<PopulateStep> recipe;
+	bool recipe_dirty = true;
+	SpinLock recipe_lock;
+
+	// Changes when the recipe is invalidated. Derived plans use it to notice changes in the base plan.
+	uint32_t recipe_version = 0;
+	uint32_t base_recipe_version = 0;
+
+	_FORCE_INLINE_ void _invalidate_recipe() {
+		recipe_dirty = true;
+		recipe_version++;
+	}
+	void _compile_recipe();
+	void _ensure_recipe();
+
+	// Expects the variable to be in the plan.
+	_FORCE_INLINE_ BBVariable &_get_var_ref(const StringName &p_name) { return var_list[var_index[p_name]].second; }
+	_FORCE_INLINE_ const BBVariable &_get_var_ref(const StringName &p_name) const { return var_list[var_index[p_name]].second; }
+	void _rebuild_var_index(uint32_t p_from = 0);
 
 	_FORCE_INLINE_ bool _is_var_nil(const BBVariable &p_var) const { return p_var.get_type() == Variant::NIL; }
 	_FORCE_INLINE_ bool _is_var_private(const String &p_name, const BBVariable &p_var) const { return is_derived() && p_name.begins_with("_"); }
 
+	void _share_default(const BBVariable &p_var) const;
+	void _populate_step(const Ref<Blackboard> &p_blackboard, const PopulateStep &p_step, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan);
+
 protected:
 	static void _bind_methods();
 
@@ -86,13 +136,21 @@ public:
 	void set_prefetch_nodepath_vars(bool p_enable);
 	bool is_prefetching_nodepath_vars() const;
 
+	void set_lazy_nodepath_prefetch(bool p_enable);
+	bool is_lazy_nodepath_prefetch() const { return lazy_nodepath_prefetch; }
+
+	bool accesses_scene() const;
+
+	void set_share_defaults(bool p_enable);
+	bool is_sharing_defaults() const { return share_defaults; }
+
 	void add_var(const StringName &p_name, const BBVariable &p_var);
 	void remove_var(const StringName &p_name);
 	BBVariable get_var(const StringName &p_name);
 	Pair<StringName, BBVariable> get_var_by_index(int p_index);
-	_FORCE_INLINE_ bool has_var(const StringName &p_name) { return var_map.has(p_name); }
-	_FORCE_INLINE_ bool is_empty() const { return var_map.is_empty(); }
-	int get_var_count() const { return var_map.size(); }
+	_FORCE_INLINE_ bool has_var(const StringName &p_name) { return var_index.has(p_name); }
+	_FORCE_INLINE_ bool is_empty() const { return var_list.is_empty(); }
+	int get_var_count() const { return var_list.size(); }
 
 	TypedArray<StringName> list_vars() const;
 	StringName get_var_name(const BBVariable &p_var) const;
@@ -102,10 +160,11 @@ public:
 
 	void sync_with_base_plan();
 	_FORCE_INLINE_ bool is_derived() const { return base.is_valid(); }
-	_FORCE_INLINE_ bool is_derived_var_changed(const StringName &p_name) const { return base.is_valid() && var_map.has(p_name) && var_map[p_name].is_value_changed(); }
+	_FORCE_INLINE_ bool is_derived_var_changed(const StringName &p_name) const { return base.is_valid() && var_index.has(p_name) && _get_var_ref(p_name).is_value_changed(); }
 
 	Ref<Blackboard> create_blackboard(Node *p_prefetch_root, const Ref<Blackboard> &p_parent_scope = Ref<Blackboard>(), Node *p_prefetch_root_for_base_plan = nullptr);
 	void populate_blackboard(const Ref<Blackboard> &p_blackboard, bool overwrite, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan = nullptr);
+	void reset_blackboard(const Ref<Blackboard> &p_blackboard, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan = nullptr);
 
 	BlackboardPlan();
 };
@@ -10,6 +10,7 @@
  */
 
 #include "behavior_tree.h"
+#include "bt_scheduler.h"
 #include "tasks/utility/bt_fail.h"
 
 #include "../util/limbo_string_names.h"
@@ -57,12 +58,38 @@ void BehaviorTree::set_root_task(const Ref<BTTask> &p_value) {
 	_unset_editor_behavior_tree_hint();
 #endif // TOOLS_ENABLED
 	root_task = p_value;
+	_clear_pool();
 #ifdef TOOLS_ENABLED
 	_set_editor_behavior_tree_hint();
 #endif // TOOLS_ENABLED
 	emit_changed();
 }
 
+void BehaviorTree::set_share_sub_resources(bool p_share) {
+	share_sub_resources = p_share;
+	emit_changed();
+}
+
+Ref<BTTask> BehaviorTree::clone_root_task() const {
+	ERR_FAIL_COND_V(root_task.is_null(), nullptr);
+	return share_sub_resources ? root_task->clone_shared() : root_task->clone();
+}
+
+BitField<BTTask::Capability> BehaviorTree::get_task_capabilities() const {
+	if (root_task.is_null()) {
+		return BTTask::CAPABILITY_PURE;
+	}
+	return root_task->get_branch_capabilities();
+}
+
+bool BehaviorTree::is_thread_safe() const {
+	if (root_task.is_null() || (uint32_t)get_task_capabilities() != BTTask::CAPABILITY_PURE) {
+		return false;
+	}
+	// Bound properties and lazy node paths access the scene when variables are used.
+	return blackboard_plan.is_null() || !blackboard_plan->accesses_scene();
+}
+
 Ref<BehaviorTree> BehaviorTree::clone() const {
 	Ref<BehaviorTree> copy = duplicate(false);
 	copy->set_path("");
@@ -78,6 +105,16 @@ void BehaviorTree::copy_other(const Ref<BehaviorTree> &p_other) {
 	root_task = p_other->get_root_task();
 }
 
+Ref<BTTask> BehaviorTree::_instantiate_root() const {
+	Ref<BTTask> new_root = clone_root_task();
+	if (new_root.is_null()) {
+		ERR_FAIL_COND_V_MSG(root_task->is_enabled_in_tree(), nullptr, "BehaviorTree: Instantiation failed - unable to clone root task.");
+		new_root = Ref(memnew(BTFail));
+		new_root->set_custom_name("Root task disabled");
+	}
+	return new_root;
+}
+
 Ref<BTInstance> BehaviorTree::instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root) const {
 	ERR_FAIL_COND_V_MSG(root_task.is_null(), nullptr, "BehaviorTree: Instantiation failed - BT has no valid root task.");
 	ERR_FAIL_NULL_V_MSG(p_agent, nullptr, "BehaviorTree: Instantiation failed - agent can't be null.");
@@ -85,14 +122,139 @@ Ref<BTInstance> BehaviorTree::instantiate(Node *p_agent, const Ref<Blackboard> &
 	ERR_FAIL_COND_V_MSG(p_blackboard.is_null(), nullptr, "BehaviorTree: Instantiation failed - blackboard can't be null.");
 	Node *scene_root = p_custom_scene_root ? p_custom_scene_root : p_instance_owner->get_owner();
 	ERR_FAIL_NULL_V_MSG(scene_root, nullptr, "BehaviorTree: Instantiation failed - unable to establish scene root. This is likely due to the instance owner not being owned by a scene node and custom_scene_root being null.");
-	Ref<BTTask> new_root = root_task->clone();
-	if (new_root.is_null()) {
-		ERR_FAIL_COND_V_MSG(root_task->is_enabled_in_tree(), nullptr, "BehaviorTree: Instantiation failed - unable to clone root task.");
-		new_root = Ref(memnew(BTFail));
-		new_root->set_custom_name("Root task disabled");
-	}
+	Ref<BTTask> new_root = _instantiate_root();
+	ERR_FAIL_COND_V(new_root.is_null(), nullptr);
 	new_root->initialize(p_agent, p_blackboard, scene_root);
-	return BTInstance::create(new_root, get_path(), p_instance_owner);
+	Ref<BTInstance> inst = BTInstance::create(new_root, get_path(), p_instance_owner);
+	ERR_FAIL_COND_V(inst.is_null(), nullptr);
+	inst->tree_thread_safe = is_thread_safe();
+	return inst;
+}
+
+// Clone phase of pooled instantiation. It doesn't need an agent or the scene, so it can run ahead of time,
+// including on a background thread. The tree shouldn't be modified meanwhile.
+Ref<BTInstance> BehaviorTree::instantiate_unbound() const {
+	ERR_FAIL_COND_V_MSG(root_task.is_null(), nullptr, "BehaviorTree: Instantiation failed - BT has no valid root task.");
+	Ref<BTTask> new_root = _instantiate_root();
+	ERR_FAIL_COND_V(new_root.is_null(), nullptr);
+
+	// Variables that depend on the scene are populated when the instance is bound.
+	Ref<Blackboard> bb = memnew(Blackboard);
+	if (blackboard_plan.is_valid()) {
+		blackboard_plan->reset_blackboard(bb, nullptr);
+	}
+	new_root->data.blackboard = bb;
+
+	Ref<BTInstance> inst;
+	inst.instantiate();
+	inst->root_task = new_root;
+	inst->source_bt_path = get_path();
+	inst->pool_tree_id = get_instance_id();
+	inst->pool_blackboard = bb;
+	inst->tree_thread_safe = is_thread_safe();
+	inst->_build_task_table();
+	return inst;
+}
+
+// Can be called on a background thread. The instances are cloned outside of the lock.
+void BehaviorTree::prewarm_pool(int p_count) {
+	ERR_FAIL_COND_MSG(root_task.is_null(), "BehaviorTree: Can't prewarm the pool - BT has no valid root task.");
+	pool_lock.lock();
+	uint32_t generation = pool_generation;
+	pool_lock.unlock();
+
+	LocalVector<Ref<BTInstance>> prewarmed;
+	prewarmed.reserve(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Ref<BTInstance> inst = instantiate_unbound();
+		ERR_BREAK(inst.is_null());
+		inst->in_pool = true;
+		prewarmed.push_back(inst);
+	}
+
+	pool_lock.lock();
+	if (generation == pool_generation) {
+		for (const Ref<BTInstance> &inst : prewarmed) {
+			instance_pool.push_back(inst);
+		}
+		prewarmed.clear();
+	}
+	pool_lock.unlock();
+	// Instances of a changed tree are freed here, outside of the lock.
+}
+
+int BehaviorTree::get_pooled_instance_count() const {
+	pool_lock.lock();
+	int count = instance_pool.size();
+	pool_lock.unlock();
+	return count;
+}
+
+void BehaviorTree::_clear_pool() {
+	LocalVector<Ref<BTInstance>> released;
+	pool_lock.lock();
+	SWAP(released, instance_pool);
+	pool_generation++;
+	pool_lock.unlock();
+	// Instances are freed when `released` goes out of scope, outside of the lock.
+}
+
+// Bind phase of pooled instantiation.
+void BehaviorTree::_bind_instance(const Ref<BTInstance> &p_instance, Node *p_agent, Node *p_instance_owner, Node *p_scene_root, const Ref<Blackboard> &p_parent_scope) {
+	Ref<Blackboard> bb = p_instance->pool_blackboard;
+	bb->set_parent(p_parent_scope);
+	if (blackboard_plan.is_valid()) {
+		// A previously bound instance is restored to the plan defaults; a fresh one is only missing the scene-dependent variables.
+		if (p_instance->owner_node_id != 0) {
+			blackboard_plan->reset_blackboard(bb, p_instance_owner, p_scene_root);
+		} else {
+			blackboard_plan->populate_blackboard(bb, false, p_instance_owner, p_scene_root);
+		}
+	} else {
+		bb->clear();
+	}
+	p_instance->in_pool = false;
+	p_instance->owner_node_id = p_instance_owner->get_instance_id();
+	p_instance->get_root_task()->initialize(p_agent, bb, p_scene_root);
+	// Initialization may add tasks, such as the subtree of BTSubtree.
+	p_instance->_build_task_table();
+}
+
+Ref<BTInstance> BehaviorTree::instantiate_pooled(Node *p_agent, Node *p_instance_owner, Node *p_custom_scene_root, const Ref<Blackboard> &p_parent_scope) {
+	ERR_FAIL_NULL_V_MSG(p_agent, nullptr, "BehaviorTree: Instantiation failed - agent can't be null.");
+	ERR_FAIL_NULL_V_MSG(p_instance_owner, nullptr, "BehaviorTree: Instantiation failed -- instance owner can't be null.");
+	Node *scene_root = p_custom_scene_root ? p_custom_scene_root : p_instance_owner->get_owner();
+	ERR_FAIL_NULL_V_MSG(scene_root, nullptr, "BehaviorTree: Instantiation failed - unable to establish scene root. This is likely due to the instance owner not being owned by a scene node and custom_scene_root being null.");
+
+	Ref<BTInstance> inst;
+	pool_lock.lock();
+	if (!instance_pool.is_empty()) {
+		// The most recently released instance is recycled first.
+		inst = instance_pool[instance_pool.size() - 1];
+		instance_pool.resize(instance_pool.size() - 1);
+	}
+	pool_lock.unlock();
+	if (inst.is_null()) {
+		inst = instantiate_unbound();
+		ERR_FAIL_COND_V(inst.is_null(), nullptr);
+	}
+	_bind_instance(inst, p_agent, p_instance_owner, scene_root, p_parent_scope);
+	return inst;
+}
+
+void BehaviorTree::release_instance(const Ref<BTInstance> &p_instance) {
+	ERR_FAIL_COND(p_instance.is_null());
+	ERR_FAIL_COND_MSG(p_instance->pool_tree_id != get_instance_id(), "BehaviorTree: Can't release an instance that wasn't created by instantiate_pooled() or instantiate_unbound() of this behavior tree.");
+	ERR_FAIL_COND_MSG(p_instance->in_pool, "BehaviorTree: Instance is already released.");
+
+	if (p_instance->scheduler_group != -1 && BTScheduler::get_singleton()) {
+		BTScheduler::get_singleton()->remove_instance(p_instance);
+	}
+	p_instance->_recycle();
+	p_instance->in_pool = true;
+	pool_lock.lock();
+	instance_pool.push_back(p_instance);
+	pool_lock.unlock();
 }
 
 void BehaviorTree::emit_branch_changed(const Ref<BTTask> &p_branch) {
@@ -100,6 +262,7 @@ void BehaviorTree::emit_branch_changed(const Ref<BTTask> &p_branch) {
 }
 
 void BehaviorTree::_plan_changed() {
+	_clear_pool();
 	emit_signal(LW_NAME(plan_changed));
 	emit_changed();
 }
@@ -127,12 +290,23 @@ void BehaviorTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &BehaviorTree::get_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("set_root_task", "task"), &BehaviorTree::set_root_task);
 	ClassDB::bind_method(D_METHOD("get_root_task"), &BehaviorTree::get_root_task);
+	ClassDB::bind_method(D_METHOD("set_share_sub_resources", "enable"), &BehaviorTree::set_share_sub_resources);
+	ClassDB::bind_method(D_METHOD("is_sharing_sub_resources"), &BehaviorTree::is_sharing_sub_resources);
+	ClassDB::bind_method(D_METHOD("get_task_capabilities"), &BehaviorTree::get_task_capabilities);
+	ClassDB::bind_method(D_METHOD("is_thread_safe"), &BehaviorTree::is_thread_safe);
 	ClassDB::bind_method(D_METHOD("clone"), &BehaviorTree::clone);
 	ClassDB::bind_method(D_METHOD("copy_other", "other"), &BehaviorTree::copy_other);
 	ClassDB::bind_method(D_METHOD("instantiate", "agent", "blackboard", "instance_owner", "custom_scene_root"), &BehaviorTree::instantiate, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("instantiate_unbound"), &BehaviorTree::instantiate_unbound);
+	ClassDB::bind_method(D_METHOD("prewarm_pool", "count"), &BehaviorTree::prewarm_pool);
+	ClassDB::bind_method(D_METHOD("instantiate_pooled", "agent", "instance_owner", "custom_scene_root", "parent_scope"), &BehaviorTree::instantiate_pooled, DEFVAL(Variant()), DEFVAL(Ref<Blackboard>()));
+	ClassDB::bind_method(D_METHOD("release_instance", "instance"), &BehaviorTree::release_instance);
+	ClassDB::bind_method(D_METHOD("get_pooled_instance_count"), &BehaviorTree::get_pooled_instance_count);
+	ClassDB::bind_method(D_METHOD("clear_instance_pool"), &BehaviorTree::clear_instance_pool);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "description", PROPERTY_HINT_MULTILINE_TEXT), "set_description", "get_description");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_blackboard_plan", "get_blackboard_plan");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "share_sub_resources"), "set_share_sub_resources", "is_sharing_sub_resources");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root_task", PROPERTY_HINT_RESOURCE_TYPE, "BTTask", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "set_root_task", "get_root_task");
 
 	ADD_SIGNAL(MethodInfo("plan_changed"));
@@ -18,10 +18,12 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/io/resource.h"
+#include "core/os/spin_lock.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/templates/spin_lock.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
@@ -32,8 +34,19 @@ private:
 	String description;
 	Ref<BlackboardPlan> blackboard_plan;
 	Ref<BTTask> root_task;
+	bool share_sub_resources = false;
+
+	// Released instances, ready to be recycled by instantiate_pooled().
+	// Guarded by pool_lock, as the pool may be prewarmed on a background thread.
+	LocalVector<Ref<BTInstance>> instance_pool;
+	mutable SpinLock pool_lock;
+	// Changes when the pool is cleared, so that instances cloned from the previous tree are not added to it.
+	uint32_t pool_generation = 0;
 
 	void _plan_changed();
+	void _clear_pool();
+	Ref<BTTask> _instantiate_root() const;
+	void _bind_instance(const Ref<BTInstance> &p_instance, Node *p_agent, Node *p_instance_owner, Node *p_scene_root, const Ref<Blackboard> &p_parent_scope);
 
 #ifdef TOOLS_ENABLED
 	void _set_editor_behavior_tree_hint();
@@ -61,10 +74,25 @@ public:
 	void set_root_task(const Ref<BTTask> &p_value);
 	Ref<BTTask> get_root_task() const { return root_task; }
 
+	void set_share_sub_resources(bool p_share);
+	bool is_sharing_sub_resources() const { return share_sub_resources; }
+
+	Ref<BTTask> clone_root_task() const;
+
+	BitField<BTTask::Capability> get_task_capabilities() const;
+	bool is_thread_safe() const;
+
 	Ref<BehaviorTree> clone() const;
 	void copy_other(const Ref<BehaviorTree> &p_other);
 	Ref<BTInstance> instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root = nullptr) const;
 
+	Ref<BTInstance> instantiate_unbound() const;
+	void prewarm_pool(int p_count);
+	Ref<BTInstance> instantiate_pooled(Node *p_agent, Node *p_instance_owner, Node *p_custom_scene_root = nullptr, const Ref<Blackboard> &p_parent_scope = Ref<Blackboard>());
+	void release_instance(const Ref<BTInstance> &p_instance);
+	int get_pooled_instance_count() const;
+	void clear_instance_pool() { _clear_pool(); }
+
 	void emit_branch_changed(const Ref<BTTask> &p_branch);
 
 	BehaviorTree();
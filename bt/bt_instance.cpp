@@ -15,15 +15,22 @@
 #include "../compat/performance.h"
 #include "../editor/debugger/limbo_debugger.h"
 #include "../util/limbo_string_names.h"
+#include "tasks/composites/bt_dynamic_selector.h"
+#include "tasks/composites/bt_dynamic_sequence.h"
+#include "tasks/composites/bt_parallel.h"
+#include "tasks/composites/bt_selector.h"
+#include "tasks/composites/bt_sequence.h"
 
 #ifdef LIMBOAI_MODULE
 #include "core/object/callable_mp.h"
+#include "core/object/script_language.h"
 #include "core/os/time.h"
 #include "main/performance.h"
 #endif
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/script.hpp>
 #include <godot_cpp/classes/time.hpp>
 #endif
 
@@ -39,19 +46,380 @@ Ref<BTInstance> BTInstance::create(Ref<BTTask> p_root_task, String p_source_bt_p
 	inst->root_task = p_root_task;
 	inst->owner_node_id = p_owner_node->get_instance_id();
 	inst->source_bt_path = p_source_bt_path;
+	inst->_build_task_table();
 	return inst;
 }
 
-BT::Status BTInstance::update(double p_delta) {
-	ERR_FAIL_COND_V(!root_task.is_valid(), BT::FRESH);
+void BTInstance::_build_task_table() {
+	task_table.clear();
+	task_table_version = root_task->data.structure_version;
+	// The running path may point to removed tasks.
+	running_path.clear();
+
+	// Iterative pre-order traversal using raw pointers to avoid refcount churn.
+	LocalVector<TaskEntry> stack;
+	stack.push_back({ root_task.ptr(), -1, 0, 0 });
+	while (!stack.is_empty()) {
+		TaskEntry entry = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+
+		int idx = task_table.size();
+		task_table.push_back(entry);
+
+		BTTask *task = entry.task;
+		for (int i = task->get_child_count() - 1; i >= 0; i--) {
+			stack.push_back({ task->get_child_ptr(i), idx, entry.depth + 1, 0 });
+		}
+	}
+
+	// Resolve subtree ranges in reverse order: each task extends its parent's range.
+	for (int i = task_table.size() - 1; i >= 0; i--) {
+		TaskEntry &entry = task_table[i];
+		if (entry.subtree_end < i + 1) {
+			entry.subtree_end = i + 1;
+		}
+		if (entry.parent >= 0 && task_table[entry.parent].subtree_end < entry.subtree_end) {
+			task_table[entry.parent].subtree_end = entry.subtree_end;
+		}
+	}
+
+	if (compiled) {
+		_compile();
+	}
+#ifdef DEBUG_ENABLED
+	if (profile_tasks) {
+		_setup_task_profiler();
+	}
+#endif
+}
+
+void BTInstance::set_compiled(bool p_compiled) {
+	compiled = p_compiled;
+	program.clear();
+	child_jumps.clear();
+	if (compiled && root_task.is_valid()) {
+		_compile();
+	}
+}
+
+BTInstance::Opcode BTInstance::_get_opcode(BTTask *p_task) {
+	// Only exact native classes are lowered, since scripts and subclasses may change the behavior.
+	Ref<Script> sc = GET_SCRIPT(p_task);
+	if (sc.is_valid()) {
+		return OP_TASK;
+	}
+	const String class_name = p_task->get_class();
+	if (class_name == String(BTSequence::get_class_static())) {
+		return OP_SEQUENCE;
+	} else if (class_name == String(BTSelector::get_class_static())) {
+		return OP_SELECTOR;
+	} else if (class_name == String(BTDynamicSequence::get_class_static())) {
+		return OP_DYNAMIC_SEQUENCE;
+	} else if (class_name == String(BTDynamicSelector::get_class_static())) {
+		return OP_DYNAMIC_SELECTOR;
+	} else if (class_name == String(BTParallel::get_class_static())) {
+		return OP_PARALLEL;
+	}
+	return OP_TASK;
+}
+
+void BTInstance::_compile() {
+	program.clear();
+	child_jumps.clear();
+	program.resize(task_table.size());
+	for (uint32_t i = 0; i < task_table.size(); i++) {
+		Instruction &ins = program[i];
+		ins.op = _get_opcode(task_table[i].task);
+		if (ins.op == OP_TASK) {
+			continue;
+		}
+		// Direct children are found by skipping over the subtree of each child.
+		ins.first_child = child_jumps.size();
+		for (int j = i + 1; j < task_table[i].subtree_end; j = task_table[j].subtree_end) {
+			child_jumps.push_back(j);
+		}
+		ins.child_count = child_jumps.size() - ins.first_child;
+	}
+}
+
+// Executes the task at p_index like BTTask::execute() would, interpreting lowered composites in place.
+// Lowered composites have no scripts and don't implement _exit(), so these calls are left out.
+BT::Status BTInstance::_run(uint32_t p_index, double p_delta) {
+	const Instruction &ins = program[p_index];
+	BTTask *task = task_table[p_index].task;
+	if (ins.op == OP_TASK) {
+		return task->execute(p_delta);
+	}
+#ifdef DEBUG_ENABLED
+	const LimboTaskProfiler::Sample profile_sample(task);
+#endif
+
+	if (unlikely(!task->data.touched)) {
+		task->_mark_touched();
+	}
+	const uint32_t *children = child_jumps.ptr() + ins.first_child;
+	const int child_count = ins.child_count;
+	if (task->data.status != BT::RUNNING) {
+		if (task->data.status != BT::FRESH) {
+			for (int i = 0; i < child_count; i++) {
+				task_table[children[i]].task->abort();
+			}
+		}
+		task->_enter();
+	} else {
+		task->data.elapsed += p_delta;
+	}
+
+	BT::Status status = BT::FAILURE;
+	switch (ins.op) {
+		case OP_SEQUENCE: {
+			BTSequence *sequence = static_cast<BTSequence *>(task);
+			status = BT::SUCCESS;
+			for (int i = sequence->last_running_idx; i < child_count; i++) {
+				status = _run(children[i], p_delta);
+				if (status != BT::SUCCESS) {
+					sequence->last_running_idx = i;
+					break;
+				}
+			}
+		} break;
+		case OP_SELECTOR: {
+			BTSelector *selector = static_cast<BTSelector *>(task);
+			status = BT::FAILURE;
+			for (int i = selector->last_running_idx; i < child_count; i++) {
+				status = _run(children[i], p_delta);
+				if (status != BT::FAILURE) {
+					selector->last_running_idx = i;
+					break;
+				}
+			}
+		} break;
+		case OP_DYNAMIC_SEQUENCE:
+		case OP_DYNAMIC_SELECTOR: {
+			// Both re-evaluate all children; only the status that lets them continue differs.
+			const BT::Status proceed = ins.op == OP_DYNAMIC_SEQUENCE ? BT::SUCCESS : BT::FAILURE;
+			int &last_running_idx = ins.op == OP_DYNAMIC_SEQUENCE ? static_cast<BTDynamicSequence *>(task)->last_running_idx : static_cast<BTDynamicSelector *>(task)->last_running_idx;
+			status = BT::SUCCESS;
+			int i;
+			for (i = 0; i < child_count; i++) {
+				status = _run(children[i], p_delta);
+				if (status != proceed) {
+					break;
+				}
+			}
+			// Cancel the previous runner if it comes later than the last child ticked.
+			if (last_running_idx > i && last_running_idx < child_count) {
+				BTTask *previous = task_table[children[last_running_idx]].task;
+				if (previous->data.status == BT::RUNNING) {
+					previous->abort();
+				}
+			}
+			last_running_idx = i;
+		} break;
+		case OP_PARALLEL: {
+			BTParallel *parallel = static_cast<BTParallel *>(task);
+			const bool repeat = parallel->get_repeat();
+			int num_succeeded = 0;
+			int num_failed = 0;
+			status = BT::RUNNING;
+			for (int i = 0; i < child_count; i++) {
+				BTTask *child = task_table[children[i]].task;
+				BT::Status child_status = child->data.status;
+				if (repeat || (child_status != BT::FAILURE && child_status != BT::SUCCESS)) {
+					child_status = _run(children[i], p_delta);
+				}
+				if (child_status == BT::FAILURE) {
+					num_failed += 1;
+					if (num_failed >= parallel->get_num_failures_required() && status == BT::RUNNING) {
+						status = BT::FAILURE;
+					}
+				} else if (child_status == BT::SUCCESS) {
+					num_succeeded += 1;
+					if (num_succeeded >= parallel->get_num_successes_required() && status == BT::RUNNING) {
+						status = BT::SUCCESS;
+					}
+				}
+			}
+			if (!repeat && (num_failed + num_succeeded) == child_count && status == BT::RUNNING) {
+				status = BT::FAILURE;
+			}
+		} break;
+		case OP_TASK: {
+		} break;
+	}
+
+	task->data.status = status;
+	if (status != BT::RUNNING) {
+		task->data.elapsed = 0.0;
+	}
+	return status;
+}
+
+Ref<BTTask> BTInstance::get_task(int p_index) {
+	_ensure_task_table();
+	ERR_FAIL_INDEX_V(p_index, (int)task_table.size(), nullptr);
+	return Ref<BTTask>(task_table[p_index].task);
+}
+
+int BTInstance::find_task(const Ref<BTTask> &p_task) {
+	_ensure_task_table();
+	for (uint32_t i = 0; i < task_table.size(); i++) {
+		if (task_table[i].task == p_task.ptr()) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+void BTInstance::reset() {
+	ERR_FAIL_COND(!root_task.is_valid());
+	root_task->abort();
+	last_status = BT::FRESH;
+	running_path.clear();
+}
+
+// Returns the instance to its initial state before it's stored in a pool.
+void BTInstance::_recycle() {
+	reset();
+	set_reactive(false);
+	reevaluation_requested = false;
+	thread_safe = false;
+	use_command_buffer = false;
+	command_buffer.clear();
+	set_compiled(false);
+
+	// Connections of the previous owner shouldn't receive updates of the next one.
+#ifdef LIMBOAI_MODULE
+	List<Connection> connections;
+	get_signal_connection_list(LW_NAME(updated), &connections);
+	for (const Connection &c : connections) {
+		disconnect(LW_NAME(updated), c.callable);
+	}
+#elif LIMBOAI_GDEXTENSION
+	TypedArray<Dictionary> connections = get_signal_connection_list(LW_NAME(updated));
+	for (int i = 0; i < connections.size(); i++) {
+		Dictionary c = connections[i];
+		disconnect(LW_NAME(updated), c["callable"]);
+	}
+#endif
+
+	set_monitor_performance(false);
+	set_profile_tasks(false);
+	unregister_with_debugger();
+}
+
+void BTInstance::set_reactive(bool p_reactive) {
+	reactive = p_reactive;
+	running_path.clear();
+}
+
+void BTInstance::_update_running_path(const Blackboard *p_tick_scope, uint64_t p_tick_scope_version) {
+	running_path.clear();
+	path_reevaluates = false;
+	reevaluation_requested = false;
+
+	BTTask *task = root_task.ptr();
+	if (task->data.status != BT::RUNNING) {
+		return;
+	}
+	running_path.push_back(task);
+
+	// Descend through tasks that only pass control to their running child.
+	while (task->is_resumable()) {
+		BTTask *running_child = nullptr;
+		for (int i = 0; i < task->data.children.size(); i++) {
+			BTTask *child = task->data.children[i].ptr();
+			if (child->data.status == BT::RUNNING) {
+				running_child = child;
+				break;
+			}
+		}
+		if (running_child == nullptr) {
+			break;
+		}
+		path_reevaluates = path_reevaluates || task->_reevaluates_children();
+		task = running_child;
+		running_path.push_back(task);
+	}
+
+	path_blackboard_version = 0;
+	if (path_reevaluates) {
+		if (task->data.blackboard.ptr() == p_tick_scope) {
+			path_blackboard_version = p_tick_scope_version;
+		} else {
+			// The version of this scope before the tick is unknown, so the tree is executed from the root once more.
+			reevaluation_requested = true;
+		}
+	}
+}
+
+uint64_t BTInstance::_get_blackboard_version(const BTTask *p_task) const {
+	// Sum of versions along the scope chain changes whenever any of the scopes changes.
+	uint64_t version = 0;
+	const Blackboard *bb = p_task->data.blackboard.ptr();
+	while (bb) {
+		version += bb->get_version() + bb->get_linked_version();
+		bb = bb->get_parent().ptr();
+	}
+	return version;
+}
+
+bool BTInstance::_can_resume() const {
+	if (running_path.is_empty() || reevaluation_requested) {
+		return false;
+	}
+	const BTTask *last = running_path[running_path.size() - 1];
+	if (root_task->data.status != BT::RUNNING || last->data.status != BT::RUNNING) {
+		// Tree was aborted or modified outside of update().
+		return false;
+	}
+	return !path_reevaluates || _get_blackboard_version(last) == path_blackboard_version;
+}
 
+BT::Status BTInstance::_resume(double p_delta, const Blackboard *p_tick_scope, uint64_t p_tick_scope_version) {
+	const int last = running_path.size() - 1;
+	for (int i = 0; i < last; i++) {
+		running_path[i]->data.elapsed += p_delta;
+	}
+
+	BT::Status status = running_path[last]->execute(p_delta);
+	if (status == BT::RUNNING) {
+		return status;
+	}
+
+	// Pass the result up the path, as the skipped tasks would have done.
+	for (int i = last - 1; i >= 0 && status != BT::RUNNING; i--) {
+		status = running_path[i]->_resume_after_child(status, p_delta);
+	}
+	_update_running_path(p_tick_scope, p_tick_scope_version);
+	return root_task->get_status();
+}
+
+BT::Status BTInstance::_execute(double p_delta, bool p_on_worker_thread) {
 #ifdef DEBUG_ENABLED
 	double start = Time::get_singleton()->get_ticks_usec();
+	const LimboTaskProfiler::Scope profile_scope(profile_tasks ? &task_profiler : nullptr);
 #endif
 
-	const Ref<BTInstance> keep_alive{ this }; // keep instance alive until update is finished
-	last_status = root_task->execute(p_delta);
-	emit_signal(LW_NAME(updated), last_status);
+	_ensure_task_table();
+	const LimboCommandBuffer::Scope command_scope((use_command_buffer || p_on_worker_thread) ? &command_buffer : nullptr);
+	const Blackboard *tick_scope = nullptr;
+	uint64_t tick_scope_version = 0;
+	if (reactive) {
+		// The running task's scope is the one most likely to be on the path after the tick.
+		const BTTask *scope_task = running_path.is_empty() ? root_task.ptr() : running_path[running_path.size() - 1];
+		tick_scope = scope_task->data.blackboard.ptr();
+		tick_scope_version = _get_blackboard_version(scope_task);
+	}
+
+	if (reactive && _can_resume()) {
+		last_status = _resume(p_delta, tick_scope, tick_scope_version);
+	} else {
+		last_status = compiled ? _run(0, p_delta) : root_task->execute(p_delta);
+		if (reactive) {
+			_update_running_path(tick_scope, tick_scope_version);
+		}
+	}
 
 #ifdef DEBUG_ENABLED
 	double end = Time::get_singleton()->get_ticks_usec();
@@ -61,6 +429,36 @@ BT::Status BTInstance::update(double p_delta) {
 	return last_status;
 }
 
+void BTInstance::set_thread_safe(bool p_thread_safe) {
+	if (p_thread_safe) {
+		ERR_FAIL_COND_MSG(!tree_thread_safe, "BTInstance: Can't mark instance as thread-safe - its behavior tree isn't thread-safe (see BehaviorTree.is_thread_safe()).");
+		// Scopes may also be populated from other plans, such as the ones of BTPlayer and BTNewScope.
+		_ensure_task_table();
+		const Blackboard *last_scope = nullptr;
+		for (const TaskEntry &entry : task_table) {
+			const Blackboard *scope = entry.task->data.blackboard.ptr();
+			if (scope == nullptr || scope == last_scope) {
+				continue;
+			}
+			last_scope = scope;
+			ERR_FAIL_COND_MSG(scope->has_bound_vars(), "BTInstance: Can't mark instance as thread-safe - its blackboard has variables bound to object properties.");
+			// Worker threads can't access the scene tree, so lazy node paths are resolved now.
+			scope->resolve_node_paths();
+		}
+	}
+	thread_safe = p_thread_safe;
+}
+
+BT::Status BTInstance::update(double p_delta) {
+	ERR_FAIL_COND_V(!root_task.is_valid(), BT::FRESH);
+
+	const Ref<BTInstance> keep_alive{ this }; // keep instance alive until update is finished
+	_execute(p_delta);
+	command_buffer.flush();
+	emit_signal(LW_NAME(updated), last_status);
+	return last_status;
+}
+
 void BTInstance::set_monitor_performance(bool p_monitor) {
 #ifdef DEBUG_ENABLED
 	monitor_performance = p_monitor;
@@ -80,6 +478,57 @@ bool BTInstance::get_monitor_performance() const {
 #endif
 }
 
+void BTInstance::set_profile_tasks(bool p_enable) {
+#ifdef DEBUG_ENABLED
+	if (profile_tasks == p_enable) {
+		return;
+	}
+	profile_tasks = p_enable;
+	task_profiler.clear();
+	if (profile_tasks && root_task.is_valid()) {
+		_setup_task_profiler();
+	}
+#endif
+}
+
+bool BTInstance::is_profiling_tasks() const {
+#ifdef DEBUG_ENABLED
+	return profile_tasks;
+#else
+	return false;
+#endif
+}
+
+void BTInstance::reset_task_profile() {
+#ifdef DEBUG_ENABLED
+	task_profiler.reset_stats();
+#endif
+}
+
+Dictionary BTInstance::get_task_profile(int p_index) {
+	Dictionary profile;
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_INDEX_V(p_index, get_task_count(), profile);
+	const LimboTaskProfiler::Stats *stats = get_task_stats(p_index);
+	if (stats) {
+		profile["calls"] = (int64_t)stats->calls;
+		profile["inclusive_usec"] = (int64_t)stats->inclusive_usec;
+		profile["exclusive_usec"] = (int64_t)stats->exclusive_usec;
+	}
+#endif
+	return profile;
+}
+
+#ifdef DEBUG_ENABLED
+const LimboTaskProfiler::Stats *BTInstance::get_task_stats(int p_index) {
+	_ensure_task_table();
+	if (!profile_tasks || p_index < 0 || p_index >= task_profiler.get_task_count()) {
+		return nullptr;
+	}
+	return &task_profiler.get_stats(p_index);
+}
+#endif
+
 void BTInstance::register_with_debugger() {
 #ifdef DEBUG_ENABLED
 	if (LimboDebugger::get_singleton()->is_active()) {
@@ -128,6 +577,14 @@ void BTInstance::_remove_custom_monitor() {
 	}
 }
 
+void BTInstance::_setup_task_profiler() {
+	// Tasks are added in task table order, so profiler indices match the table.
+	task_profiler.clear();
+	for (const TaskEntry &entry : task_table) {
+		task_profiler.add_task(entry.task);
+	}
+}
+
 #endif // * DEBUG_ENABLED
 
 void BTInstance::_bind_methods() {
@@ -139,16 +596,39 @@ void BTInstance::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_blackboard"), &BTInstance::get_blackboard);
 
 	ClassDB::bind_method(D_METHOD("is_instance_valid"), &BTInstance::is_instance_valid);
+	ClassDB::bind_method(D_METHOD("get_task_count"), &BTInstance::get_task_count);
+	ClassDB::bind_method(D_METHOD("get_task", "index"), &BTInstance::get_task);
+	ClassDB::bind_method(D_METHOD("find_task", "task"), &BTInstance::find_task);
+	ClassDB::bind_method(D_METHOD("reset"), &BTInstance::reset);
+	ClassDB::bind_method(D_METHOD("set_reactive", "enable"), &BTInstance::set_reactive);
+	ClassDB::bind_method(D_METHOD("is_reactive"), &BTInstance::is_reactive);
+	ClassDB::bind_method(D_METHOD("request_reevaluation"), &BTInstance::request_reevaluation);
+	ClassDB::bind_method(D_METHOD("set_thread_safe", "thread_safe"), &BTInstance::set_thread_safe);
+	ClassDB::bind_method(D_METHOD("is_thread_safe"), &BTInstance::is_thread_safe);
+	ClassDB::bind_method(D_METHOD("set_use_command_buffer", "enable"), &BTInstance::set_use_command_buffer);
+	ClassDB::bind_method(D_METHOD("is_using_command_buffer"), &BTInstance::is_using_command_buffer);
+	ClassDB::bind_method(D_METHOD("set_compiled", "compiled"), &BTInstance::set_compiled);
+	ClassDB::bind_method(D_METHOD("is_compiled"), &BTInstance::is_compiled);
 
 	ClassDB::bind_method(D_METHOD("set_monitor_performance", "monitor"), &BTInstance::set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("get_monitor_performance"), &BTInstance::get_monitor_performance);
 
+	ClassDB::bind_method(D_METHOD("set_profile_tasks", "enable"), &BTInstance::set_profile_tasks);
+	ClassDB::bind_method(D_METHOD("is_profiling_tasks"), &BTInstance::is_profiling_tasks);
+	ClassDB::bind_method(D_METHOD("reset_task_profile"), &BTInstance::reset_task_profile);
+	ClassDB::bind_method(D_METHOD("get_task_profile", "index"), &BTInstance::get_task_profile);
+
 	ClassDB::bind_method(D_METHOD("update", "delta"), &BTInstance::update);
 
 	ClassDB::bind_method(D_METHOD("register_with_debugger"), &BTInstance::register_with_debugger);
 	ClassDB::bind_method(D_METHOD("unregister_with_debugger"), &BTInstance::unregister_with_debugger);
 
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compiled"), "set_compiled", "is_compiled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "set_monitor_performance", "get_monitor_performance");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "profile_tasks"), "set_profile_tasks", "is_profiling_tasks");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "reactive"), "set_reactive", "is_reactive");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "thread_safe"), "set_thread_safe", "is_thread_safe");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_command_buffer"), "set_use_command_buffer", "is_using_command_buffer");
 
 	ADD_SIGNAL(MethodInfo("updated", PropertyInfo(Variant::INT, "status")));
 	ADD_SIGNAL(MethodInfo("freed"));
@@ -11,29 +11,126 @@
 #ifndef BT_INSTANCE_H
 #define BT_INSTANCE_H
 
+#include "../util/limbo_command_buffer.h"
+#include "../util/limbo_task_profiler.h"
 #include "tasks/bt_task.h"
 
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
 class BTInstance : public RefCounted {
 	GDCLASS(BTInstance, RefCounted);
+	friend class BTScheduler;
+	friend class BehaviorTree;
+
+public:
+	// Entry of the flattened task table. Tasks are stored in depth-first order,
+	// so the descendants of a task occupy the range (index, subtree_end).
+	struct TaskEntry {
+		BTTask *task = nullptr;
+		int parent = -1;
+		int depth = 0;
+		int subtree_end = 0;
+	};
 
 private:
 	Ref<BTTask> root_task;
+	LocalVector<TaskEntry> task_table;
+	uint32_t task_table_version = 0; // Structure version of the root task when the table was built.
 	uint64_t owner_node_id = 0;
 	String source_bt_path;
 	BT::Status last_status = BT::FRESH;
 
+	// Reactive updates: tasks on the running path are skipped, and the last one is resumed directly.
+	bool reactive = false;
+	bool reevaluation_requested = false;
+	bool path_reevaluates = false;
+	uint64_t path_blackboard_version = 0;
+	LocalVector<BTTask *> running_path;
+
+	// Position in BTScheduler, if registered.
+	int scheduler_group = -1;
+	uint32_t scheduler_slot = 0;
+	bool thread_safe = false;
+	// Set if the source tree passed BehaviorTree::is_thread_safe() at instantiation.
+	bool tree_thread_safe = false;
+
+	// Set for instances created with BehaviorTree::instantiate_unbound() and instantiate_pooled().
+	uint64_t pool_tree_id = 0;
+	bool in_pool = false;
+	// The root task may replace it with a scope of its own, such as BTNewScope does.
+	Ref<Blackboard> pool_blackboard;
+
+	// Scene writes made during an update, applied at the end of it.
+	bool use_command_buffer = false;
+	LimboCommandBuffer command_buffer;
+
+	// Compiled backend: core composites are lowered into instructions interpreted by _run(),
+	// while other tasks are executed as usual. Instructions are parallel to the task table.
+	enum Opcode : uint8_t {
+		OP_TASK,
+		OP_SEQUENCE,
+		OP_SELECTOR,
+		OP_DYNAMIC_SEQUENCE,
+		OP_DYNAMIC_SELECTOR,
+		OP_PARALLEL,
+	};
+
+	struct Instruction {
+		Opcode op = OP_TASK;
+		uint32_t first_child = 0; // Offset in child_jumps.
+		uint32_t child_count = 0;
+	};
+
+	bool compiled = false;
+	LocalVector<Instruction> program;
+	LocalVector<uint32_t> child_jumps; // Task table indices of the children of lowered composites.
+
 #ifdef DEBUG_ENABLED
 	bool monitor_performance = false;
 	StringName monitor_id;
 	double update_time_acc = 0.0;
 	double update_time_n = 0.0;
 
+	// Per-task profiling: stats are parallel to the task table.
+	bool profile_tasks = false;
+	LimboTaskProfiler task_profiler;
+
 	double _get_mean_update_time_msec_and_reset();
 	void _add_custom_monitor();
 	void _remove_custom_monitor();
+	void _setup_task_profiler();
 
 #endif // * DEBUG_ENABLED
 
+	void _build_task_table();
+	// The table holds raw pointers, so it's rebuilt before use if tasks were added or removed since.
+	_FORCE_INLINE_ void _ensure_task_table() {
+		if (unlikely(root_task.is_valid() && root_task->data.structure_version != task_table_version)) {
+			_build_task_table();
+		}
+	}
+	void _recycle();
+
+	static Opcode _get_opcode(BTTask *p_task);
+	void _compile();
+	BT::Status _run(uint32_t p_index, double p_delta);
+
+	// Blackboard versions are taken before a tick, so that writes made during it cause re-evaluation on the next one.
+	void _update_running_path(const Blackboard *p_tick_scope, uint64_t p_tick_scope_version);
+	bool _can_resume() const;
+	BT::Status _resume(double p_delta, const Blackboard *p_tick_scope, uint64_t p_tick_scope_version);
+	uint64_t _get_blackboard_version(const BTTask *p_task) const;
+
+	// Executes the tree without emitting signals, so it can be called from a worker thread.
+	// Scene writes are always recorded on worker threads, to be applied on the main thread.
+	BT::Status _execute(double p_delta, bool p_on_worker_thread = false);
+
 protected:
 	static void _bind_methods();
 
@@ -51,11 +148,46 @@ public:
 
 	_FORCE_INLINE_ bool is_instance_valid() const { return root_task.is_valid(); }
 
+	_FORCE_INLINE_ int get_task_count() {
+		_ensure_task_table();
+		return task_table.size();
+	}
+	_FORCE_INLINE_ const TaskEntry &get_task_entry(int p_index) {
+		_ensure_task_table();
+		return task_table[p_index];
+	}
+	Ref<BTTask> get_task(int p_index);
+	int find_task(const Ref<BTTask> &p_task);
+
+	void reset();
+
+	void set_reactive(bool p_reactive);
+	_FORCE_INLINE_ bool is_reactive() const { return reactive; }
+	void request_reevaluation() { reevaluation_requested = true; }
+
 	BT::Status update(double p_delta);
 
+	void set_thread_safe(bool p_thread_safe);
+	_FORCE_INLINE_ bool is_thread_safe() const { return thread_safe; }
+
+	void set_use_command_buffer(bool p_enable) { use_command_buffer = p_enable; }
+	_FORCE_INLINE_ bool is_using_command_buffer() const { return use_command_buffer; }
+
+	void set_compiled(bool p_compiled);
+	_FORCE_INLINE_ bool is_compiled() const { return compiled; }
+
 	void set_monitor_performance(bool p_monitor);
 	bool get_monitor_performance() const;
 
+	void set_profile_tasks(bool p_enable);
+	bool is_profiling_tasks() const;
+	void reset_task_profile();
+	Dictionary get_task_profile(int p_index);
+#ifdef DEBUG_ENABLED
+	// Returns null if tasks are not profiled.
+	const LimboTaskProfiler::Stats *get_task_stats(int p_index);
+#endif
+
 	void register_with_debugger();
 	void unregister_with_debugger();
 
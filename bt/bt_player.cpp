@@ -15,6 +15,7 @@
 #include "../compat/node.h"
 #include "../compat/resource.h"
 #include "../util/limbo_string_names.h"
+#include "bt_scheduler.h"
 
 #ifdef LIMBOAI_MODULE
 #include "core/config/engine.h"
@@ -79,6 +80,7 @@ void BTPlayer::_initialize_bt() {
 	bt_instance->set_monitor_performance(monitor_performance);
 	bt_instance->register_with_debugger();
 #endif // DEBUG_ENABLED
+	_update_scheduling();
 }
 
 void BTPlayer::_update_blackboard_plan() {
@@ -107,6 +109,7 @@ void BTPlayer::set_bt_instance(const Ref<BTInstance> &p_bt_instance) {
 
 	blackboard_plan.unref();
 	behavior_tree.unref();
+	_update_scheduling();
 }
 
 void BTPlayer::set_scene_root_hint(Node *p_scene_root) {
@@ -135,6 +138,7 @@ void BTPlayer::set_behavior_tree(const Ref<BehaviorTree> &p_tree) {
 	} else { // runtime
 		behavior_tree = p_tree;
 		bt_instance.unref();
+		_update_scheduling();
 
 		if (IS_NODE_READY(this)) {
 			_try_initialize();
@@ -159,12 +163,23 @@ void BTPlayer::set_update_mode(UpdateMode p_mode) {
 	set_active(active);
 }
 
+void BTPlayer::set_tick_interval(double p_seconds) {
+	tick_interval = MAX(0.0, p_seconds);
+	if (scheduled_instance.is_valid() && BTScheduler::get_singleton()) {
+		BTScheduler::get_singleton()->set_instance_tick_interval(scheduled_instance, tick_interval);
+	}
+}
+
 void BTPlayer::set_active(bool p_active) {
 	active = p_active;
+	if (!active) {
+		pending_delta = 0.0;
+	}
 	bool is_runtime = !Engine::get_singleton()->is_editor_hint();
+	bool self_process = active && is_runtime && !BTScheduler::is_enabled();
 
-	set_process(update_mode == UpdateMode::IDLE && active && is_runtime);
-	set_physics_process(update_mode == UpdateMode::PHYSICS && active && is_runtime);
+	set_process(update_mode == UpdateMode::IDLE && self_process);
+	set_physics_process(update_mode == UpdateMode::PHYSICS && self_process);
 	set_process_input(active && is_runtime);
 	set_process_unhandled_input(active && is_runtime);
 
@@ -173,6 +188,35 @@ void BTPlayer::set_active(bool p_active) {
 	if (active && is_runtime && IS_NODE_READY(this)) {
 		_try_initialize();
 	}
+	_update_scheduling();
+}
+
+void BTPlayer::_update_scheduling() {
+	// When the scheduler is enabled, it updates the tree instead of this node's process notifications.
+	Ref<BTInstance> target;
+	if (active && update_mode != UpdateMode::MANUAL && is_inside_tree() && BTScheduler::is_enabled() && !Engine::get_singleton()->is_editor_hint()) {
+		target = bt_instance;
+	}
+	BTScheduler::UpdateGroup group = update_mode == UpdateMode::IDLE ? BTScheduler::GROUP_IDLE : BTScheduler::GROUP_PHYSICS;
+	if (target.is_valid() && target == scheduled_instance && BTScheduler::get_singleton() &&
+			BTScheduler::get_singleton()->get_instance_group(target) == (int)group) {
+		return;
+	}
+
+	_unschedule();
+	if (target.is_valid()) {
+		BTScheduler *scheduler = BTScheduler::get_or_create_singleton(this);
+		ERR_FAIL_NULL(scheduler);
+		scheduler->add_player_instance(this, target, group, tick_interval);
+		scheduled_instance = target;
+	}
+}
+
+void BTPlayer::_unschedule() {
+	if (scheduled_instance.is_valid() && BTScheduler::get_singleton()) {
+		BTScheduler::get_singleton()->remove_instance(scheduled_instance);
+	}
+	scheduled_instance.unref();
 }
 
 void BTPlayer::update(double p_delta) {
@@ -183,18 +227,34 @@ void BTPlayer::update(double p_delta) {
 
 	if (active) {
 		BT::Status status = bt_instance->update(p_delta);
-		emit_signal(LW_NAME(updated), status);
+		_emit_update_signals(status);
+	}
+}
+
+void BTPlayer::_auto_update(double p_delta) {
+	// Accumulate delta until the tick interval is due, allowing half a frame of tolerance.
+	pending_delta += p_delta;
+	if (pending_delta + p_delta * 0.5 < tick_interval) {
+		return;
+	}
+	double delta = pending_delta;
+	pending_delta = 0.0;
+	update(delta);
+}
+
+void BTPlayer::_emit_update_signals(BT::Status p_status) {
+	emit_signal(LW_NAME(updated), p_status);
 #ifndef DISABLE_DEPRECATED
-		if (status == BTTask::SUCCESS || status == BTTask::FAILURE) {
-			emit_signal(LW_NAME(behavior_tree_finished), status);
-		}
-#endif // DISABLE_DEPRECATED
+	if (p_status == BTTask::SUCCESS || p_status == BTTask::FAILURE) {
+		emit_signal(LW_NAME(behavior_tree_finished), p_status);
 	}
+#endif // DISABLE_DEPRECATED
 }
 
 void BTPlayer::restart() {
 	ERR_FAIL_COND_MSG(bt_instance.is_null(), "BTPlayer: Restart failed - no valid tree instance. Make sure the BTPlayer has a valid behavior tree with a valid root task.");
-	bt_instance->get_root_task()->abort();
+	bt_instance->reset();
+	pending_delta = 0.0;
 	set_active(true);
 }
 
@@ -211,12 +271,10 @@ void BTPlayer::set_monitor_performance(bool p_monitor_performance) {
 void BTPlayer::_notification(int p_notification) {
 	switch (p_notification) {
 		case NOTIFICATION_PROCESS: {
-			Variant time = get_process_delta_time();
-			update(time);
+			_auto_update(get_process_delta_time());
 		} break;
 		case NOTIFICATION_PHYSICS_PROCESS: {
-			Variant time = get_physics_process_delta_time();
-			update(time);
+			_auto_update(get_physics_process_delta_time());
 		} break;
 		case NOTIFICATION_READY: {
 			if (Engine::get_singleton()->is_editor_hint()) {
@@ -233,8 +291,10 @@ void BTPlayer::_notification(int p_notification) {
 				bt_instance->register_with_debugger();
 			}
 #endif // DEBUG_ENABLED
+			_update_scheduling();
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			_unschedule();
 #ifdef DEBUG_ENABLED
 			if (bt_instance.is_valid()) {
 				bt_instance->set_monitor_performance(false);
@@ -258,6 +318,8 @@ void BTPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_agent_node"), &BTPlayer::get_agent_node);
 	ClassDB::bind_method(D_METHOD("set_update_mode", "update_mode"), &BTPlayer::set_update_mode);
 	ClassDB::bind_method(D_METHOD("get_update_mode"), &BTPlayer::get_update_mode);
+	ClassDB::bind_method(D_METHOD("set_tick_interval", "seconds"), &BTPlayer::set_tick_interval);
+	ClassDB::bind_method(D_METHOD("get_tick_interval"), &BTPlayer::get_tick_interval);
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &BTPlayer::set_active);
 	ClassDB::bind_method(D_METHOD("get_active"), &BTPlayer::get_active);
 	ClassDB::bind_method(D_METHOD("set_blackboard", "blackboard"), &BTPlayer::set_blackboard);
@@ -282,6 +344,7 @@ void BTPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "behavior_tree", PROPERTY_HINT_RESOURCE_TYPE, "BehaviorTree"), "set_behavior_tree", "get_behavior_tree");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "agent_node"), "set_agent_node", "get_agent_node");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,Manual"), "set_update_mode", "get_update_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "tick_interval", PROPERTY_HINT_RANGE, "0,10,0.001,or_greater,suffix:s"), "set_tick_interval", "get_tick_interval");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "get_active");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard", PROPERTY_HINT_NONE, "Blackboard", PROPERTY_USAGE_EDITOR_INSPECT()), "set_blackboard", "get_blackboard");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT | PROPERTY_USAGE_ALWAYS_DUPLICATE), "set_blackboard_plan", "get_blackboard_plan");
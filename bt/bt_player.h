@@ -28,6 +28,7 @@
 
 class BTPlayer : public Node {
 	GDCLASS(BTPlayer, Node);
+	friend class BTScheduler;
 
 public:
 	enum UpdateMode : unsigned int {
@@ -41,17 +42,24 @@ private:
 	NodePath agent_node;
 	Ref<BlackboardPlan> blackboard_plan;
 	UpdateMode update_mode = UpdateMode::PHYSICS;
+	double tick_interval = 0.0;
+	double pending_delta = 0.0;
 	bool active = true;
 	Ref<Blackboard> blackboard;
 	Node *scene_root_hint = nullptr;
 	bool monitor_performance = false;
 
 	Ref<BTInstance> bt_instance;
+	Ref<BTInstance> scheduled_instance;
 
 	void _try_initialize();
 	void _initialize_blackboard();
 	void _initialize_bt();
 	void _update_blackboard_plan();
+	void _update_scheduling();
+	void _unschedule();
+	void _emit_update_signals(BT::Status p_status);
+	void _auto_update(double p_delta);
 	_FORCE_INLINE_ Node *_get_scene_root() const { return scene_root_hint ? scene_root_hint : get_owner(); }
 
 protected:
@@ -76,6 +84,9 @@ public:
 	void set_update_mode(UpdateMode p_mode);
 	UpdateMode get_update_mode() const { return update_mode; }
 
+	void set_tick_interval(double p_seconds);
+	double get_tick_interval() const { return tick_interval; }
+
 	void set_active(bool p_active);
 	bool get_active() const { return active; }
 
@@ -0,0 +1,466 @@
+/**
+ * bt_scheduler.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_scheduler.h"
+
+#include "../compat/object.h"
+#include "../compat/project_settings.h"
+#include "../util/limbo_string_names.h"
+#include "bt_player.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/worker_thread_pool.h"
+#include "core/os/time.h"
+#include "scene/2d/camera_2d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#ifndef _3D_DISABLED
+#include "scene/3d/camera_3d.h"
+#endif // ! _3D_DISABLED
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/camera2d.hpp>
+#include <godot_cpp/classes/camera3d.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/window.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+BTScheduler *BTScheduler::singleton = nullptr;
+bool BTScheduler::enabled = false;
+int BTScheduler::default_tick_budget_usec = 0;
+bool BTScheduler::default_use_threads = false;
+
+void BTScheduler::initialize() {
+	enabled = GLOBAL_DEF("limbo_ai/behavior_tree/use_scheduler", false);
+	default_tick_budget_usec = GLOBAL_DEF(PropertyInfo(Variant::INT, "limbo_ai/behavior_tree/scheduler_tick_budget_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), 0);
+	default_use_threads = GLOBAL_DEF("limbo_ai/behavior_tree/scheduler_use_threads", false);
+}
+
+// Frees the singleton created by get_or_create_singleton(). Called when the module is uninitialized.
+void BTScheduler::finalize() {
+	if (singleton) {
+		memdelete(singleton);
+	}
+}
+
+// The singleton is created on demand and updated by the scene tree of p_context.
+BTScheduler *BTScheduler::get_or_create_singleton(Node *p_context) {
+	ERR_FAIL_NULL_V(p_context, nullptr);
+	ERR_FAIL_COND_V_MSG(!p_context->is_inside_tree(), nullptr, "BTScheduler: Context node must be inside the scene tree.");
+	BTScheduler *scheduler = singleton ? singleton : memnew(BTScheduler);
+	scheduler->_set_tree(p_context->get_tree());
+	return scheduler;
+}
+
+void BTScheduler::_set_tree(Object *p_tree) {
+	const uint64_t id = p_tree ? (uint64_t)p_tree->get_instance_id() : 0;
+	if (id == tree_id) {
+		return;
+	}
+	// Connections are removed with the previous tree if it was freed.
+	Object *prev_tree = OBJECT_DB_GET_INSTANCE(tree_id);
+	if (prev_tree) {
+		if (prev_tree->is_connected(LW_NAME(process_frame), callable_mp(this, &BTScheduler::_on_process_frame))) {
+			prev_tree->disconnect(LW_NAME(process_frame), callable_mp(this, &BTScheduler::_on_process_frame));
+		}
+		if (prev_tree->is_connected(LW_NAME(physics_frame), callable_mp(this, &BTScheduler::_on_physics_frame))) {
+			prev_tree->disconnect(LW_NAME(physics_frame), callable_mp(this, &BTScheduler::_on_physics_frame));
+		}
+	}
+	tree_id = id;
+	_update_processing();
+}
+
+void BTScheduler::add_player_instance(BTPlayer *p_player, const Ref<BTInstance> &p_instance, UpdateGroup p_group, double p_tick_interval) {
+	ERR_FAIL_COND(p_instance.is_null());
+	ERR_FAIL_INDEX(p_group, GROUP_MAX);
+
+	if (p_instance->scheduler_group != -1) {
+		remove_instance(p_instance);
+	}
+
+	Group &group = groups[p_group];
+	p_instance->scheduler_group = p_group;
+	p_instance->scheduler_slot = group.entries.size();
+	Entry entry{ p_instance, p_player, group.time, MAX(0.0, p_tick_interval) };
+	_update_tick_interval(entry);
+	group.entries.push_back(entry);
+	_update_processing();
+}
+
+void BTScheduler::remove_instance(const Ref<BTInstance> &p_instance) {
+	ERR_FAIL_COND(p_instance.is_null());
+	if (p_instance->scheduler_group == -1) {
+		return;
+	}
+
+	// Only clear the slot: removal may happen while the group is being updated.
+	Group &group = groups[p_instance->scheduler_group];
+	Entry &entry = group.entries[p_instance->scheduler_slot];
+	p_instance->scheduler_group = -1;
+	entry.player = nullptr;
+	entry.instance.unref();
+	group.needs_compaction = true;
+}
+
+int BTScheduler::get_instance_group(const Ref<BTInstance> &p_instance) const {
+	ERR_FAIL_COND_V(p_instance.is_null(), -1);
+	return p_instance->scheduler_group;
+}
+
+int BTScheduler::get_instance_count(UpdateGroup p_group) const {
+	ERR_FAIL_INDEX_V(p_group, GROUP_MAX, 0);
+	int count = 0;
+	for (const Entry &entry : groups[p_group].entries) {
+		count += entry.instance.is_valid();
+	}
+	return count;
+}
+
+void BTScheduler::set_instance_tick_interval(const Ref<BTInstance> &p_instance, double p_seconds) {
+	ERR_FAIL_COND(p_instance.is_null());
+	ERR_FAIL_COND_MSG(p_instance->scheduler_group == -1, "BTScheduler: Instance is not registered.");
+	Entry &entry = groups[p_instance->scheduler_group].entries[p_instance->scheduler_slot];
+	entry.base_interval = MAX(0.0, p_seconds);
+	_update_tick_interval(entry);
+}
+
+double BTScheduler::get_instance_tick_interval(const Ref<BTInstance> &p_instance) const {
+	ERR_FAIL_COND_V(p_instance.is_null(), 0.0);
+	ERR_FAIL_COND_V_MSG(p_instance->scheduler_group == -1, 0.0, "BTScheduler: Instance is not registered.");
+	return groups[p_instance->scheduler_group].entries[p_instance->scheduler_slot].tick_interval;
+}
+
+void BTScheduler::set_lod_distances(const PackedFloat32Array &p_distances) {
+	for (int i = 1; i < p_distances.size(); i++) {
+		ERR_FAIL_COND_MSG(p_distances[i] < p_distances[i - 1], "BTScheduler: LOD distances must be in ascending order.");
+	}
+	ERR_FAIL_COND_MSG(!lod_intervals.is_empty() && p_distances.size() != lod_intervals.size(),
+			"BTScheduler: LOD distances and intervals must have the same size. Use set_lod_levels() to change the number of levels.");
+	lod_distances = p_distances;
+}
+
+void BTScheduler::set_lod_intervals(const PackedFloat32Array &p_intervals) {
+	for (int i = 0; i < p_intervals.size(); i++) {
+		ERR_FAIL_COND_MSG(p_intervals[i] < 0.0, "BTScheduler: LOD intervals can't be negative.");
+	}
+	ERR_FAIL_COND_MSG(!lod_distances.is_empty() && p_intervals.size() != lod_distances.size(),
+			"BTScheduler: LOD distances and intervals must have the same size. Use set_lod_levels() to change the number of levels.");
+	lod_intervals = p_intervals;
+}
+
+void BTScheduler::set_lod_levels(const PackedFloat32Array &p_distances, const PackedFloat32Array &p_intervals) {
+	ERR_FAIL_COND_MSG(p_distances.size() != p_intervals.size(), "BTScheduler: LOD distances and intervals must have the same size.");
+	lod_distances.clear();
+	lod_intervals.clear();
+	set_lod_distances(p_distances);
+	set_lod_intervals(p_intervals);
+	if (lod_distances.size() != lod_intervals.size()) {
+		// Validation failed: don't leave a partial configuration.
+		lod_distances.clear();
+		lod_intervals.clear();
+	}
+}
+
+double BTScheduler::_get_lod_interval(const BTInstance *p_instance) const {
+	const int num_levels = MIN(lod_distances.size(), lod_intervals.size());
+	if (num_levels == 0) {
+		return 0.0;
+	}
+
+	Node *agent = p_instance->get_agent();
+	real_t distance = 0.0;
+	if (Node2D *agent_2d = Object::cast_to<Node2D>(agent)) {
+		Camera2D *camera = agent_2d->get_viewport()->get_camera_2d();
+		if (camera == nullptr) {
+			return 0.0;
+		}
+		distance = agent_2d->get_global_position().distance_to(camera->get_screen_center_position());
+	}
+#if defined(LIMBOAI_GDEXTENSION) || !defined(_3D_DISABLED)
+	else if (Node3D *agent_3d = Object::cast_to<Node3D>(agent)) {
+		Camera3D *camera = agent_3d->get_viewport()->get_camera_3d();
+		if (camera == nullptr) {
+			return 0.0;
+		}
+		distance = agent_3d->get_global_position().distance_to(camera->get_global_position());
+	}
+#endif
+	else {
+		return 0.0;
+	}
+
+	for (int i = num_levels - 1; i >= 0; i--) {
+		if (distance >= lod_distances[i]) {
+			return lod_intervals[i];
+		}
+	}
+	return 0.0;
+}
+
+void BTScheduler::_update_tick_interval(Entry &p_entry) const {
+	p_entry.tick_interval = p_entry.base_interval;
+	if (!lod_distances.is_empty() && p_entry.instance->get_agent() && p_entry.instance->get_agent()->is_inside_tree()) {
+		p_entry.tick_interval = MAX(p_entry.tick_interval, _get_lod_interval(p_entry.instance.ptr()));
+	}
+}
+
+void BTScheduler::_compact(UpdateGroup p_group) {
+	Group &group = groups[p_group];
+	LocalVector<Entry> &entries = group.entries;
+	uint32_t dst = 0;
+	uint32_t cursor = 0;
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		if (i == group.cursor) {
+			cursor = dst;
+		}
+		if (entries[i].instance.is_null()) {
+			continue;
+		}
+		if (dst != i) {
+			entries[dst] = entries[i];
+		}
+		entries[dst].instance->scheduler_slot = dst;
+		dst++;
+	}
+	entries.resize(dst);
+	group.cursor = cursor;
+	group.needs_compaction = false;
+	_update_processing();
+}
+
+uint64_t BTScheduler::_get_ticks_usec() {
+	return Time::get_singleton()->get_ticks_usec();
+}
+
+void BTScheduler::_update_group(UpdateGroup p_group, double p_delta, bool p_paused) {
+	ERR_FAIL_INDEX(p_group, GROUP_MAX);
+	Group &group = groups[p_group];
+	LocalVector<Entry> &entries = group.entries;
+
+	// Each instance receives the group time passed since its last update,
+	// so instances skipped due to the budget catch up on the next update.
+	const double prev_time = group.time;
+	group.time += p_delta;
+
+	if (use_threads) {
+		_update_threaded(group, p_delta, p_paused);
+	}
+
+	// Instances added during the update are picked up on the next one.
+	const uint32_t count = entries.size();
+	const bool limited = tick_budget_usec > 0;
+	const uint64_t start_usec = limited ? ticks_usec_func() : 0;
+	const uint32_t first = (limited && group.cursor < count) ? group.cursor : 0;
+	uint32_t num_updated = 0;
+
+	for (uint32_t n = 0; n < count; n++) {
+		const uint32_t i = (first + n) % count;
+		BTInstance *instance = entries[i].instance.ptr();
+		BTPlayer *player = entries[i].player;
+		if (instance == nullptr || (use_threads && instance->thread_safe)) {
+			continue;
+		}
+		if (player ? !player->can_process() : p_paused) {
+			// Paused instances don't accumulate time.
+			entries[i].last_update_time = group.time;
+			continue;
+		}
+		// Instances with a tick interval wait until it's due, allowing half a frame of tolerance.
+		const double last_time = entries[i].last_update_time;
+		if (group.time - last_time + p_delta * 0.5 < entries[i].tick_interval) {
+			continue;
+		}
+		// At least one instance is updated each time to guarantee progress.
+		if (limited && num_updated > 0 && ticks_usec_func() - start_usec >= (uint64_t)tick_budget_usec) {
+			group.cursor = i;
+			break;
+		}
+
+		const double delta = last_time == prev_time ? p_delta : group.time - last_time;
+		entries[i].last_update_time = group.time;
+		BT::Status status = instance->update(delta);
+		num_updated += 1;
+
+		// Entries may be reallocated or cleared by the update, so the slot is re-read.
+		if (entries[i].instance.ptr() == instance) {
+			_finish_update(entries[i], status);
+		}
+	}
+
+	if (group.needs_compaction) {
+		_compact(p_group);
+	}
+}
+
+void BTScheduler::_update_threaded(Group &p_group, double p_delta, bool p_paused) {
+	LocalVector<Entry> &entries = p_group.entries;
+	const double prev_time = p_group.time - p_delta;
+
+	// Collect thread-safe instances that are due. Everything that may touch
+	// the scene (process checks, signals, LOD) stays on the main thread.
+	thread_jobs.clear();
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		Entry &entry = entries[i];
+		if (entry.instance.is_null() || !entry.instance->thread_safe) {
+			continue;
+		}
+		if (entry.player ? !entry.player->can_process() : p_paused) {
+			entry.last_update_time = p_group.time;
+			continue;
+		}
+		if (p_group.time - entry.last_update_time + p_delta * 0.5 < entry.tick_interval) {
+			continue;
+		}
+		const double delta = entry.last_update_time == prev_time ? p_delta : p_group.time - entry.last_update_time;
+		entry.last_update_time = p_group.time;
+		thread_jobs.push_back({ entry.instance, entry.player, i, delta });
+	}
+	if (thread_jobs.is_empty()) {
+		return;
+	}
+
+#ifdef LIMBOAI_MODULE
+	WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(
+			&BTScheduler::_thread_job_native, this, thread_jobs.size(), -1, true, "BTScheduler");
+#elif LIMBOAI_GDEXTENSION
+	int64_t group_id = WorkerThreadPool::get_singleton()->add_group_task(
+			callable_mp(this, &BTScheduler::_thread_job), thread_jobs.size(), -1, true, "BTScheduler");
+#endif
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+
+	// Commit phase: apply buffered scene writes and emit signals in registration order.
+	for (ThreadJob &job : thread_jobs) {
+		job.instance->command_buffer.flush();
+		job.instance->emit_signal(LW_NAME(updated), job.status);
+		// Signal handlers may remove entries.
+		if (job.slot < entries.size() && entries[job.slot].instance == job.instance) {
+			_finish_update(entries[job.slot], job.status);
+		}
+	}
+	thread_jobs.clear();
+}
+
+void BTScheduler::_thread_job(uint32_t p_index) {
+	ThreadJob &job = thread_jobs[p_index];
+	job.status = job.instance->_execute(job.delta, true);
+}
+
+#ifdef LIMBOAI_MODULE
+void BTScheduler::_thread_job_native(void *p_scheduler, uint32_t p_index) {
+	static_cast<BTScheduler *>(p_scheduler)->_thread_job(p_index);
+}
+#endif // LIMBOAI_MODULE
+
+void BTScheduler::_finish_update(Entry &p_entry, BT::Status p_status) {
+	if (!lod_distances.is_empty()) {
+		_update_tick_interval(p_entry);
+	}
+	if (p_entry.player) {
+		p_entry.player->_emit_update_signals(p_status);
+	}
+}
+
+void BTScheduler::_update_processing() {
+	SceneTree *tree = Object::cast_to<SceneTree>(OBJECT_DB_GET_INSTANCE(tree_id));
+	if (tree == nullptr) {
+		return;
+	}
+	const Callable on_process = callable_mp(this, &BTScheduler::_on_process_frame);
+	const bool process = !groups[GROUP_IDLE].entries.is_empty();
+	if (process != tree->is_connected(LW_NAME(process_frame), on_process)) {
+		if (process) {
+			tree->connect(LW_NAME(process_frame), on_process);
+		} else {
+			tree->disconnect(LW_NAME(process_frame), on_process);
+		}
+	}
+	const Callable on_physics = callable_mp(this, &BTScheduler::_on_physics_frame);
+	const bool physics = !groups[GROUP_PHYSICS].entries.is_empty();
+	if (physics != tree->is_connected(LW_NAME(physics_frame), on_physics)) {
+		if (physics) {
+			tree->connect(LW_NAME(physics_frame), on_physics);
+		} else {
+			tree->disconnect(LW_NAME(physics_frame), on_physics);
+		}
+	}
+}
+
+void BTScheduler::set_tick_budget_usec(int p_budget_usec) {
+	tick_budget_usec = MAX(0, p_budget_usec);
+}
+
+void BTScheduler::_on_process_frame() {
+	SceneTree *tree = Object::cast_to<SceneTree>(OBJECT_DB_GET_INSTANCE(tree_id));
+	ERR_FAIL_NULL(tree);
+	_update_group(GROUP_IDLE, tree->get_root()->get_process_delta_time(), tree->is_paused());
+}
+
+void BTScheduler::_on_physics_frame() {
+	SceneTree *tree = Object::cast_to<SceneTree>(OBJECT_DB_GET_INSTANCE(tree_id));
+	ERR_FAIL_NULL(tree);
+	_update_group(GROUP_PHYSICS, tree->get_root()->get_physics_process_delta_time(), tree->is_paused());
+}
+
+void BTScheduler::_bind_methods() {
+	ClassDB::bind_static_method("BTScheduler", D_METHOD("get_singleton"), &BTScheduler::get_singleton);
+
+	ClassDB::bind_method(D_METHOD("add_instance", "instance", "group", "tick_interval"), &BTScheduler::add_instance, DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("remove_instance", "instance"), &BTScheduler::remove_instance);
+	ClassDB::bind_method(D_METHOD("get_instance_group", "instance"), &BTScheduler::get_instance_group);
+	ClassDB::bind_method(D_METHOD("get_instance_count", "group"), &BTScheduler::get_instance_count);
+	ClassDB::bind_method(D_METHOD("set_instance_tick_interval", "instance", "seconds"), &BTScheduler::set_instance_tick_interval);
+	ClassDB::bind_method(D_METHOD("get_instance_tick_interval", "instance"), &BTScheduler::get_instance_tick_interval);
+	ClassDB::bind_method(D_METHOD("update_group", "group", "delta"), &BTScheduler::update_group);
+	ClassDB::bind_method(D_METHOD("set_tick_budget_usec", "budget_usec"), &BTScheduler::set_tick_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_tick_budget_usec"), &BTScheduler::get_tick_budget_usec);
+	ClassDB::bind_method(D_METHOD("set_use_threads", "enable"), &BTScheduler::set_use_threads);
+	ClassDB::bind_method(D_METHOD("get_use_threads"), &BTScheduler::get_use_threads);
+	ClassDB::bind_method(D_METHOD("set_lod_distances", "distances"), &BTScheduler::set_lod_distances);
+	ClassDB::bind_method(D_METHOD("get_lod_distances"), &BTScheduler::get_lod_distances);
+	ClassDB::bind_method(D_METHOD("set_lod_intervals", "intervals"), &BTScheduler::set_lod_intervals);
+	ClassDB::bind_method(D_METHOD("get_lod_intervals"), &BTScheduler::get_lod_intervals);
+	ClassDB::bind_method(D_METHOD("set_lod_levels", "distances", "intervals"), &BTScheduler::set_lod_levels);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "tick_budget_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater,suffix:usec"), "set_tick_budget_usec", "get_tick_budget_usec");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "get_use_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "lod_distances"), "set_lod_distances", "get_lod_distances");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "lod_intervals"), "set_lod_intervals", "get_lod_intervals");
+
+	BIND_ENUM_CONSTANT(GROUP_IDLE);
+	BIND_ENUM_CONSTANT(GROUP_PHYSICS);
+}
+
+BTScheduler::BTScheduler() {
+	if (singleton == nullptr) {
+		singleton = this;
+	}
+	// Players check their own process mode; unowned instances follow the tree's pause state.
+	tick_budget_usec = default_tick_budget_usec;
+	use_threads = default_use_threads;
+}
+
+BTScheduler::~BTScheduler() {
+	for (int g = 0; g < GROUP_MAX; g++) {
+		for (Entry &entry : groups[g].entries) {
+			if (entry.instance.is_valid()) {
+				entry.instance->scheduler_group = -1;
+			}
+		}
+	}
+	_set_tree(nullptr);
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,151 @@
+/**
+ * bt_scheduler.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_SCHEDULER_H
+#define BT_SCHEDULER_H
+
+#include "bt_instance.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/object.h"
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+class BTPlayer;
+
+// Updates registered behavior tree instances from a single process loop,
+// instead of each BTPlayer node processing on its own.
+// The singleton is owned by the module and driven by the frame signals of the SceneTree.
+class BTScheduler : public Object {
+	GDCLASS(BTScheduler, Object);
+
+public:
+	enum UpdateGroup : unsigned int {
+		GROUP_IDLE, // updated on SceneTree.process_frame
+		GROUP_PHYSICS, // updated on SceneTree.physics_frame
+		GROUP_MAX,
+	};
+
+private:
+	struct Entry {
+		Ref<BTInstance> instance;
+		BTPlayer *player = nullptr;
+		double last_update_time = 0.0; // group time of the last update
+		double base_interval = 0.0; // requested by the player or set_instance_tick_interval()
+		double tick_interval = 0.0; // effective interval, including the distance LOD
+	};
+
+	// Instance updated on a worker thread; signals are emitted afterwards on the main thread.
+	struct ThreadJob {
+		Ref<BTInstance> instance;
+		BTPlayer *player = nullptr;
+		uint32_t slot = 0;
+		double delta = 0.0;
+		BT::Status status = BT::FRESH;
+	};
+
+	struct Group {
+		LocalVector<Entry> entries;
+		bool needs_compaction = false;
+		uint32_t cursor = 0; // round-robin position when the budget is limited
+		double time = 0.0; // accumulated delta of the group
+	};
+
+	static BTScheduler *singleton;
+	static bool enabled;
+	static int default_tick_budget_usec;
+	static bool default_use_threads;
+
+	Group groups[GROUP_MAX];
+	int tick_budget_usec = 0;
+	bool use_threads = false;
+	LocalVector<ThreadJob> thread_jobs;
+
+	// SceneTree that drives the updates.
+	uint64_t tree_id = 0;
+
+	// Clock used for the tick budget. Replaceable, so that budget tests don't depend on wall-clock time.
+	uint64_t (*ticks_usec_func)() = &BTScheduler::_get_ticks_usec;
+	static uint64_t _get_ticks_usec();
+
+	// Distance LOD: agents farther than lod_distances[i] tick at most every lod_intervals[i] seconds.
+	PackedFloat32Array lod_distances;
+	PackedFloat32Array lod_intervals;
+
+	double _get_lod_interval(const BTInstance *p_instance) const;
+	void _update_tick_interval(Entry &p_entry) const;
+
+	void _update_group(UpdateGroup p_group, double p_delta, bool p_paused);
+	void _update_threaded(Group &p_group, double p_delta, bool p_paused);
+	void _thread_job(uint32_t p_index);
+#ifdef LIMBOAI_MODULE
+	static void _thread_job_native(void *p_scheduler, uint32_t p_index);
+#endif
+	void _finish_update(Entry &p_entry, BT::Status p_status);
+	void _compact(UpdateGroup p_group);
+	void _update_processing();
+	void _set_tree(Object *p_tree);
+	void _on_process_frame();
+	void _on_physics_frame();
+
+protected:
+	static void _bind_methods();
+
+public:
+	static void initialize();
+	static void finalize();
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+
+	_FORCE_INLINE_ static BTScheduler *get_singleton() { return singleton; }
+	static BTScheduler *get_or_create_singleton(Node *p_context);
+
+	void add_instance(const Ref<BTInstance> &p_instance, UpdateGroup p_group, double p_tick_interval = 0.0) { add_player_instance(nullptr, p_instance, p_group, p_tick_interval); }
+	void add_player_instance(BTPlayer *p_player, const Ref<BTInstance> &p_instance, UpdateGroup p_group, double p_tick_interval = 0.0);
+	void remove_instance(const Ref<BTInstance> &p_instance);
+	int get_instance_group(const Ref<BTInstance> &p_instance) const;
+	int get_instance_count(UpdateGroup p_group) const;
+
+	void set_instance_tick_interval(const Ref<BTInstance> &p_instance, double p_seconds);
+	double get_instance_tick_interval(const Ref<BTInstance> &p_instance) const;
+
+	void set_tick_budget_usec(int p_budget_usec);
+	int get_tick_budget_usec() const { return tick_budget_usec; }
+
+	void set_ticks_usec_func(uint64_t (*p_func)()) { ticks_usec_func = p_func ? p_func : &BTScheduler::_get_ticks_usec; }
+
+	void set_use_threads(bool p_use_threads) { use_threads = p_use_threads; }
+	bool get_use_threads() const { return use_threads; }
+
+	void set_lod_distances(const PackedFloat32Array &p_distances);
+	PackedFloat32Array get_lod_distances() const { return lod_distances; }
+
+	void set_lod_intervals(const PackedFloat32Array &p_intervals);
+	PackedFloat32Array get_lod_intervals() const { return lod_intervals; }
+
+	void set_lod_levels(const PackedFloat32Array &p_distances, const PackedFloat32Array &p_intervals);
+
+	void update_group(UpdateGroup p_group, double p_delta) { _update_group(p_group, p_delta, false); }
+
+	BTScheduler();
+	~BTScheduler();
+};
+
+VARIANT_ENUM_CAST(BTScheduler::UpdateGroup);
+
+#endif // BT_SCHEDULER_H
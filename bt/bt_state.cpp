@@ -86,7 +86,7 @@ void BTState::_setup() {
 
 void BTState::_exit() {
 	if (bt_instance.is_valid()) {
-		bt_instance->get_root_task()->abort();
+		bt_instance->reset();
 	} else {
 		ERR_PRINT_ONCE("BTState: BehaviorTree is not assigned.");
 	}
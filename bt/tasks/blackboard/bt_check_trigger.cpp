@@ -33,11 +33,16 @@ String BTCheckTrigger::_generate_name() {
 	return "CheckTrigger " + LimboUtility::get_singleton()->decorate_var(variable);
 }
 
+void BTCheckTrigger::_setup() {
+	get_blackboard()->resolve_var(variable, var_handle);
+}
+
 BT::Status BTCheckTrigger::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BBCheckVar: `variable` is not set.");
-	Variant trigger_value = get_blackboard()->get_var(variable, false);
-	if (trigger_value == Variant(true)) {
-		get_blackboard()->set_var(variable, false);
+	const BBVariable *var = get_blackboard()->resolve_var(variable, var_handle);
+	ERR_FAIL_NULL_V_MSG(var, FAILURE, vformat("Blackboard: Variable \"%s\" not found.", variable));
+	if (var->get_value() == Variant(true)) {
+		get_blackboard()->set_var_with_handle(variable, false, var_handle);
 		return SUCCESS;
 	}
 	return FAILURE;
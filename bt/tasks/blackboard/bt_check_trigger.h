@@ -17,14 +17,18 @@
 class BTCheckTrigger : public BTCondition {
 	GDCLASS(BTCheckTrigger, BTCondition);
 	TASK_CATEGORY(Blackboard);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	StringName variable;
 
+	Blackboard::VarHandle var_handle;
+
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
 
 public:
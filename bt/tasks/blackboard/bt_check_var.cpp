@@ -62,13 +62,24 @@ String BTCheckVar::_generate_name() {
 			value.is_valid() ? Variant(value) : Variant("???"));
 }
 
+void BTCheckVar::_setup() {
+	get_blackboard()->resolve_var(variable, var_handle);
+}
+
 BT::Status BTCheckVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BTCheckVar: `variable` is not set.");
 	ERR_FAIL_COND_V_MSG(!value.is_valid(), FAILURE, "BTCheckVar: `value` is not set.");
 
-	ERR_FAIL_COND_V_MSG(!get_blackboard()->has_var(variable), FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
+	const BBVariable *var = get_blackboard()->resolve_var(variable, var_handle);
+	ERR_FAIL_NULL_V_MSG(var, FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
+
+	if (var->is_stored_as(Variant::FLOAT) && value->get_value_source() == BBParam::SAVED_VALUE && value->get_saved_value_type() == Variant::FLOAT) {
+		// Fast path for the common float comparison.
+		double right_float = value->get_float_value(get_scene_root(), get_blackboard());
+		return LimboUtility::get_singleton()->perform_check_float(check_type, var->get_float(), right_float) ? SUCCESS : FAILURE;
+	}
 
-	Variant left_value = get_blackboard()->get_var(variable, Variant());
+	Variant left_value = var->get_value();
 	Variant right_value = value->get_value(get_scene_root(), get_blackboard());
 
 	return LimboUtility::get_singleton()->perform_check(check_type, left_value, right_value) ? SUCCESS : FAILURE;
@@ -20,16 +20,20 @@
 class BTCheckVar : public BTCondition {
 	GDCLASS(BTCheckVar, BTCondition);
 	TASK_CATEGORY(Blackboard);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	StringName variable;
 	LimboUtility::CheckType check_type = LimboUtility::CheckType::CHECK_EQUAL;
 	Ref<BBVariant> value;
 
+	Blackboard::VarHandle var_handle;
+
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
 
 public:
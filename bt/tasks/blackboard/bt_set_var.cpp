@@ -32,9 +32,25 @@ String BTSetVar::_generate_name() {
 			value.is_valid() ? Variant(value) : Variant("???"));
 }
 
+void BTSetVar::_setup() {
+	get_blackboard()->resolve_var(variable, var_handle);
+}
+
 BT::Status BTSetVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BTSetVar: `variable` is not set.");
 	ERR_FAIL_COND_V_MSG(!value.is_valid(), FAILURE, "BTSetVar: `value` is not set.");
+
+	if (value->get_value_source() == BBParam::SAVED_VALUE && value->get_saved_value_type() == Variant::FLOAT) {
+		// Fast path for float arithmetic on a local float variable.
+		BBVariable *var = get_blackboard()->resolve_var(variable, var_handle);
+		double result_float;
+		if (var && var_handle.depth == 0 && var->is_stored_as(Variant::FLOAT) &&
+				LimboUtility::get_singleton()->perform_operation_float(operation, var->get_float(), value->get_float_value(get_scene_root(), get_blackboard()), result_float)) {
+			get_blackboard()->set_float_with_handle(variable, result_float, var_handle);
+			return SUCCESS;
+		}
+	}
+
 	Variant result;
 	Variant error_result = LW_NAME(error_value);
 	Variant right_value = value->get_value(get_scene_root(), get_blackboard(), error_result);
@@ -42,12 +58,13 @@ BT::Status BTSetVar::_tick(double p_delta) {
 	if (operation == LimboUtility::OPERATION_NONE) {
 		result = right_value;
 	} else if (operation != LimboUtility::OPERATION_NONE) {
-		Variant left_value = get_blackboard()->get_var(variable, error_result);
-		ERR_FAIL_COND_V_MSG(left_value == error_result, FAILURE, vformat("BTSetVar: Failed to get \"%s\" blackboard variable. Returning FAILURE.", variable));
+		const BBVariable *var = get_blackboard()->resolve_var(variable, var_handle);
+		ERR_FAIL_NULL_V_MSG(var, FAILURE, vformat("BTSetVar: Failed to get \"%s\" blackboard variable. Returning FAILURE.", variable));
+		Variant left_value = var->get_value();
 		result = LimboUtility::get_singleton()->perform_operation(operation, left_value, right_value);
 		ERR_FAIL_COND_V_MSG(result == Variant(), FAILURE, "BTSetVar: Operation not valid. Returning FAILURE.");
 	}
-	get_blackboard()->set_var(variable, result);
+	get_blackboard()->set_var_with_handle(variable, result, var_handle);
 	return SUCCESS;
 };
 
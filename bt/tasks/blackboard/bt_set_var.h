@@ -20,16 +20,20 @@
 class BTSetVar : public BTAction {
 	GDCLASS(BTSetVar, BTAction);
 	TASK_CATEGORY(Blackboard);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	StringName variable;
 	Ref<BBVariant> value;
 	LimboUtility::Operation operation = LimboUtility::OPERATION_NONE;
 
+	Blackboard::VarHandle var_handle;
+
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
 
 public:
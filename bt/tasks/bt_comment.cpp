@@ -37,7 +37,7 @@ PackedStringArray BTComment::get_configuration_warnings() {
 	if (get_enabled_child_count() > 0) {
 		warnings.append("Can only have other comment tasks as children.");
 	}
-	if (get_parent().is_null()) {
+	if (is_root()) {
 		warnings.append("Can't be the root task.");
 	}
 	return warnings;
@@ -17,6 +17,7 @@
 class BTComment : public BTTask {
 	GDCLASS(BTComment, BTTask);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 protected:
 	static void _bind_methods() {}
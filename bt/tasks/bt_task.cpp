@@ -15,6 +15,7 @@
 #include "../../compat/object.h"
 #include "../../compat/print.h"
 #include "../../util/limbo_string_names.h"
+#include "../../util/limbo_task_profiler.h"
 #include "../behavior_tree.h"
 
 #ifdef LIMBOAI_MODULE
@@ -107,6 +108,7 @@ void BTTask::_set_children(Array p_children) {
 	if (num_null > 0) {
 		data.children.resize(num_children - num_null);
 	}
+	_structure_changed();
 }
 
 void BTTask::set_enabled(bool p_enabled) {
@@ -163,11 +165,15 @@ String BTTask::get_task_name() {
 }
 
 Ref<BTTask> BTTask::get_root() const {
-	const BTTask *task = this;
+	return Ref<BTTask>(get_root_ptr());
+}
+
+BTTask *BTTask::get_root_ptr() const {
+	BTTask *task = const_cast<BTTask *>(this);
 	while (!task->is_root()) {
 		task = task->data.parent;
 	}
-	return Ref<BTTask>(task);
+	return task;
 }
 
 void BTTask::set_custom_name(const String &p_name) {
@@ -184,28 +190,65 @@ void BTTask::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node
 	data.agent = p_agent;
 	data.blackboard = p_blackboard;
 	data.scene_root = p_scene_root;
+	// Dependencies are declared again in _setup(), as cached variables may belong to the previous blackboard.
+	data.var_dependencies.clear();
 	for (int i = 0; i < data.children.size(); i++) {
-		get_child(i)->initialize(p_agent, p_blackboard, p_scene_root);
+		get_child_ptr(i)->initialize(p_agent, p_blackboard, p_scene_root);
 	}
 
+	_resolve_script_overrides();
 	_setup();
 	GDVIRTUAL_CALL(_setup);
 }
 
+// Resolves once which execution virtuals need a script call, so native tasks skip the dispatch on every tick.
+void BTTask::_resolve_script_overrides() {
+	uint8_t overrides = 0;
+	Ref<Script> sc = GET_SCRIPT(this);
+	if (sc.is_valid()) {
+		// ! has_method() only reports script methods here, not the ClassDB-registered virtuals (see get_task_name()).
+		if (has_method(LW_NAME(_enter))) {
+			overrides |= SCRIPT_OVERRIDES_ENTER;
+		}
+		if (has_method(LW_NAME(_tick))) {
+			overrides |= SCRIPT_OVERRIDES_TICK;
+		}
+		if (has_method(LW_NAME(_exit))) {
+			overrides |= SCRIPT_OVERRIDES_EXIT;
+		}
+	}
+	data.script_overrides = overrides;
+}
+
 Ref<BTTask> BTTask::clone() const {
+	return _clone(false);
+}
+
+Ref<BTTask> BTTask::clone_shared() const {
+	return _clone(true);
+}
+
+Ref<BTTask> BTTask::_clone(bool p_share_sub_resources) const {
 	if (!data.enabled && !Engine::get_singleton()->is_editor_hint()) {
 		return nullptr;
 	}
 
 	// * Deep duplicate to properly copy all properties (sub-resources, arrays, dicts).
-	// * _is_cloning makes _get_children() return empty, so duplicate(true) skips children.
+	// * Native tasks may share their sub-resources with the original instead, if requested.
+	//   Scripted tasks are always deep duplicated, since scripts may modify their sub-resources.
+	// * _is_cloning makes _get_children() return empty, so duplicate() skips children.
+	bool deep = true;
+	if (p_share_sub_resources && _can_share_sub_resources()) {
+		Ref<Script> sc = GET_SCRIPT(this);
+		deep = sc.is_valid();
+	}
 	_is_cloning = true;
-	Ref<BTTask> inst = duplicate(true);
+	Ref<BTTask> inst = duplicate(deep);
 	_is_cloning = false;
 
 	// * Clone children through clone() for runtime disabled-task filtering.
 	for (int i = 0; i < data.children.size(); i++) {
-		Ref<BTTask> child = data.children[i]->clone();
+		Ref<BTTask> child = p_share_sub_resources ? data.children[i]->clone_shared() : data.children[i]->clone();
 		if (child.is_valid()) {
 			child->data.parent = inst.ptr();
 			child->data.index = inst->data.children.size();
@@ -216,7 +259,25 @@ Ref<BTTask> BTTask::clone() const {
 	return inst;
 }
 
+// Marks the task and its ancestors, so that abort() visits the path to this task.
+void BTTask::_mark_touched() {
+	for (BTTask *task = this; task && !task->data.touched; task = task->data.parent) {
+		task->data.touched = true;
+	}
+}
+
+// Lets instances notice that their task table no longer matches the tree.
+void BTTask::_structure_changed() {
+	get_root_ptr()->data.structure_version++;
+}
+
 BT::Status BTTask::execute(double p_delta) {
+#ifdef DEBUG_ENABLED
+	const LimboTaskProfiler::Sample profile_sample(this);
+#endif
+	if (unlikely(!data.touched)) {
+		_mark_touched();
+	}
 	if (data.status != RUNNING) {
 		// Reset children status.
 		if (data.status != FRESH) {
@@ -226,35 +287,121 @@ BT::Status BTTask::execute(double p_delta) {
 		}
 		// First native, then script.
 		_enter();
-		GDVIRTUAL_CALL(_enter);
+		if (data.script_overrides & SCRIPT_OVERRIDES_ENTER) {
+			GDVIRTUAL_CALL(_enter);
+		}
 	} else {
 		data.elapsed += p_delta;
 	}
 
-	if (!GDVIRTUAL_CALL(_tick, p_delta, data.status)) {
+	if (!(data.script_overrides & SCRIPT_OVERRIDES_TICK) || !GDVIRTUAL_CALL(_tick, p_delta, data.status)) {
 		data.status = _tick(p_delta);
 	}
 
 	if (data.status != RUNNING) {
-		// First script, then native.
-		GDVIRTUAL_CALL(_exit);
-		_exit();
+		_call_exit();
 		data.elapsed = 0.0;
 	}
 	return data.status;
 }
 
+void BTTask::_call_exit() {
+	// First script, then native.
+	if (data.script_overrides & SCRIPT_OVERRIDES_EXIT) {
+		GDVIRTUAL_CALL(_exit);
+	}
+	_exit();
+}
+
 void BTTask::abort() {
+	if (!data.touched) {
+		// Nothing in this subtree has been executed since the last abort.
+		return;
+	}
 	for (int i = 0; i < data.children.size(); i++) {
-		get_child(i)->abort();
+		get_child_ptr(i)->abort();
 	}
 	if (data.status == RUNNING) {
-		// First script, then native.
-		GDVIRTUAL_CALL(_exit);
-		_exit();
+		_call_exit();
 	}
 	data.status = FRESH;
 	data.elapsed = 0.0;
+	data.touched = false;
+}
+
+BT::Status BTTask::_resume_after_child(Status p_child_status, double p_delta) {
+	data.status = _resume(p_child_status, p_delta);
+
+	if (data.status != RUNNING) {
+		_call_exit();
+		data.elapsed = 0.0;
+	}
+	return data.status;
+}
+
+bool BTTask::is_resumable() const {
+	if (!_is_resumable()) {
+		return false;
+	}
+	// Scripts may override _tick(), so scripted tasks are always executed.
+	Ref<Script> sc = GET_SCRIPT(this);
+	return sc.is_null();
+}
+
+BitField<BTTask::Capability> BTTask::get_capabilities() const {
+	uint32_t caps = _get_capabilities();
+	Ref<Script> sc = GET_SCRIPT(this);
+	if (sc.is_valid()) {
+		caps |= CAPABILITY_CALLS_SCRIPTS;
+	}
+	return caps;
+}
+
+BitField<BTTask::Capability> BTTask::get_branch_capabilities() const {
+	uint32_t caps = get_capabilities();
+	for (int i = 0; i < data.children.size(); i++) {
+		// Disabled tasks are not instantiated.
+		if (data.children[i]->is_enabled()) {
+			caps |= (uint32_t)data.children[i]->get_branch_capabilities();
+		}
+	}
+	return caps;
+}
+
+void BTTask::add_var_dependency(const StringName &p_var) {
+	ERR_FAIL_COND_MSG(p_var == StringName(), "BTTask: Variable name is empty.");
+	for (const VarDependency &dep : data.var_dependencies) {
+		if (dep.name == p_var) {
+			return;
+		}
+	}
+	VarDependency dep;
+	dep.name = p_var;
+	data.var_dependencies.push_back(dep);
+}
+
+void BTTask::clear_var_dependencies() {
+	data.var_dependencies.clear();
+}
+
+bool BTTask::check_var_dependencies() {
+	ERR_FAIL_COND_V_MSG(data.blackboard.is_null(), true, "BTTask: Blackboard is null. Make sure the task is initialized.");
+	bool changed = false;
+	for (VarDependency &dep : data.var_dependencies) {
+		const BBVariable *var = data.blackboard->find_var(dep.name);
+		if (var == nullptr) {
+			// Keep reporting missing variables, so the task doesn't skip evaluation.
+			changed = true;
+			continue;
+		}
+		// Changes of bound properties can't be observed.
+		if (!var->is_same(dep.var) || var->get_version() != dep.version || var->is_bound()) {
+			dep.var = *var;
+			dep.version = var->get_version();
+			changed = true;
+		}
+	}
+	return changed;
 }
 
 int BTTask::get_enabled_child_count() const {
@@ -272,6 +419,10 @@ void BTTask::add_child(Ref<BTTask> p_child) {
 	p_child->data.parent = this;
 	p_child->data.index = data.children.size();
 	data.children.push_back(p_child);
+	if (p_child->data.touched) {
+		_mark_touched();
+	}
+	_structure_changed();
 	emit_changed();
 }
 
@@ -286,6 +437,10 @@ void BTTask::add_child_at_index(Ref<BTTask> p_child, int p_idx) {
 	for (int i = p_idx + 1; i < data.children.size(); i++) {
 		get_child(i)->data.index = i;
 	}
+	if (p_child->data.touched) {
+		_mark_touched();
+	}
+	_structure_changed();
 	emit_changed();
 }
 
@@ -298,6 +453,7 @@ void BTTask::remove_child(Ref<BTTask> p_child) {
 	for (int i = idx; i < data.children.size(); i++) {
 		get_child(i)->data.index = i;
 	}
+	_structure_changed();
 	emit_changed();
 }
 
@@ -309,6 +465,7 @@ void BTTask::remove_child_at_index(int p_idx) {
 	for (int i = p_idx; i < data.children.size(); i++) {
 		get_child(i)->data.index = i;
 	}
+	_structure_changed();
 	emit_changed();
 }
 
@@ -366,7 +523,7 @@ void BTTask::print_tree(int p_initial_tabs) {
 Ref<BehaviorTree> BTTask::editor_get_behavior_tree() {
 #ifdef TOOLS_ENABLED
 	BTTask *task = this;
-	while (task->data.behavior_tree_id.is_null() && task->get_parent().is_valid()) {
+	while (task->data.behavior_tree_id.is_null() && !task->is_root()) {
 		task = task->data.parent;
 	}
 	return Object::cast_to<BehaviorTree>(ObjectDB::get_instance(task->data.behavior_tree_id));
@@ -405,6 +562,11 @@ void BTTask::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("print_tree", "initial_tabs"), &BTTask::print_tree, Variant(0));
 	ClassDB::bind_method(D_METHOD("get_task_name"), &BTTask::get_task_name);
 	ClassDB::bind_method(D_METHOD("abort"), &BTTask::abort);
+	ClassDB::bind_method(D_METHOD("add_var_dependency", "var_name"), &BTTask::add_var_dependency);
+	ClassDB::bind_method(D_METHOD("clear_var_dependencies"), &BTTask::clear_var_dependencies);
+	ClassDB::bind_method(D_METHOD("check_var_dependencies"), &BTTask::check_var_dependencies);
+	ClassDB::bind_method(D_METHOD("get_capabilities"), &BTTask::get_capabilities);
+	ClassDB::bind_method(D_METHOD("get_branch_capabilities"), &BTTask::get_branch_capabilities);
 	ClassDB::bind_method(D_METHOD("editor_get_behavior_tree"), &BTTask::editor_get_behavior_tree);
 
 #ifndef DISABLE_DEPRECATED
@@ -438,6 +600,12 @@ void BTTask::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_enabled"), &BTTask::is_enabled);
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "_enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_INTERNAL), "_set_enabled", "is_enabled");
 
+	BIND_BITFIELD_FLAG(CAPABILITY_PURE);
+	BIND_BITFIELD_FLAG(CAPABILITY_READS_SCENE);
+	BIND_BITFIELD_FLAG(CAPABILITY_WRITES_SCENE);
+	BIND_BITFIELD_FLAG(CAPABILITY_CALLS_SCRIPTS);
+	BIND_BITFIELD_FLAG(CAPABILITY_MAIN_THREAD);
+
 	GDVIRTUAL_BIND(_setup);
 	GDVIRTUAL_BIND(_enter);
 	GDVIRTUAL_BIND(_exit);
@@ -18,6 +18,7 @@
 #ifdef LIMBOAI_MODULE
 #include "core/io/resource.h"
 #include "core/object/object.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 #include "scene/main/node.h"
 #endif // LIMBOAI_MODULE
@@ -27,6 +28,7 @@
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/core/gdvirtual.gen.inc>
 #include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/templates/vector.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
@@ -58,8 +60,34 @@ VARIANT_ENUM_CAST(BT::Status)
 class BTTask : public BT {
 	GDCLASS(BTTask, BT);
 
+public:
+	// What a task may access when it is executed. See TASK_CAPABILITIES().
+	enum Capability : unsigned int {
+		CAPABILITY_PURE = 0, // only the task's own state and its blackboard
+		CAPABILITY_READS_SCENE = 1,
+		CAPABILITY_WRITES_SCENE = 1 << 1,
+		CAPABILITY_CALLS_SCRIPTS = 1 << 2,
+		CAPABILITY_MAIN_THREAD = 1 << 3, // other side effects that must stay on the main thread, like printing
+	};
+
 private:
 	friend class BehaviorTree;
+	friend class BTInstance;
+
+	// Blackboard variable that the task reads, and the last seen state of it.
+	struct VarDependency {
+		StringName name;
+		BBVariable var;
+		uint32_t version = 0;
+	};
+
+	// Execution virtuals that are overridden by the attached script.
+	enum ScriptOverride : uint8_t {
+		SCRIPT_OVERRIDES_ENTER = 1 << 0,
+		SCRIPT_OVERRIDES_TICK = 1 << 1,
+		SCRIPT_OVERRIDES_EXIT = 1 << 2,
+		SCRIPT_OVERRIDES_ALL = SCRIPT_OVERRIDES_ENTER | SCRIPT_OVERRIDES_TICK | SCRIPT_OVERRIDES_EXIT,
+	};
 
 	// Avoid namespace pollution in the derived classes.
 	struct Data {
@@ -74,6 +102,10 @@ private:
 		double elapsed = 0.0;
 		bool display_collapsed = false;
 		bool enabled = true;
+		LocalVector<VarDependency> var_dependencies;
+		bool touched = false; // True if the task or any of its descendants has left FRESH since the last abort().
+		uint8_t script_overrides = SCRIPT_OVERRIDES_ALL; // Resolved in initialize(); until then, script virtuals are always called.
+		uint32_t structure_version = 0; // Incremented on the root task whenever tasks are added to or removed from its branch.
 #ifdef TOOLS_ENABLED
 		ObjectID behavior_tree_id;
 #endif
@@ -84,6 +116,14 @@ private:
 	Array _get_children() const;
 	void _set_children(Array children);
 
+	Ref<BTTask> _clone(bool p_share_sub_resources) const;
+	Status _resume_after_child(Status p_child_status, double p_delta);
+
+	void _resolve_script_overrides();
+	void _mark_touched();
+	void _structure_changed();
+	void _call_exit();
+
 	PackedStringArray _get_configuration_warnings(); // ! Scripts only.
 
 protected:
@@ -98,6 +138,20 @@ protected:
 	virtual void _exit() {}
 	virtual Status _tick(double p_delta) { return FAILURE; }
 
+	// Returns false if the task modifies its sub-resources, so they can't be shared between instances.
+	virtual bool _can_share_sub_resources() const { return true; }
+
+	// * Reactive updates (see BTInstance::set_reactive()).
+	// Returns true if the task only passes control to its running child, so it can be skipped while the child is running.
+	virtual bool _is_resumable() const { return false; }
+	// Returns true if the task re-evaluates its children on every tick. Such task is skipped only while the blackboard stays unchanged.
+	virtual bool _reevaluates_children() const { return false; }
+	// Continues the task after its running child finished with p_child_status, as _tick() would.
+	virtual Status _resume(Status p_child_status, double p_delta) { return p_child_status; }
+
+	// Tasks that don't declare their capabilities are assumed to access the scene.
+	virtual uint32_t _get_capabilities() const { return CAPABILITY_READS_SCENE | CAPABILITY_WRITES_SCENE; }
+
 	GDVIRTUAL0RC(String, _generate_name);
 	GDVIRTUAL0(_setup);
 	GDVIRTUAL0(_enter);
@@ -136,11 +190,19 @@ public:
 	Ref<BTTask> get_root() const;
 
 	virtual Ref<BTTask> clone() const;
+	Ref<BTTask> clone_shared() const;
 	virtual void initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root);
 	virtual PackedStringArray get_configuration_warnings(); // ! Native version.
 
 	Status execute(double p_delta);
 	void abort();
+	bool is_resumable() const;
+	BitField<Capability> get_capabilities() const;
+	BitField<Capability> get_branch_capabilities() const;
+
+	void add_var_dependency(const StringName &p_var);
+	void clear_var_dependencies();
+	bool check_var_dependencies();
 
 	_FORCE_INLINE_ Ref<BTTask> get_parent() const { return Ref<BTTask>(data.parent); }
 	_FORCE_INLINE_ bool is_root() const { return data.parent == nullptr; }
@@ -153,6 +215,14 @@ public:
 		return data.children.get(p_idx);
 	}
 
+	// Raw accessors for hot paths. Unlike the ones returning Ref, they don't touch the reference count.
+	_FORCE_INLINE_ BTTask *get_child_ptr(int p_idx) const {
+		ERR_FAIL_INDEX_V(p_idx, data.children.size(), nullptr);
+		return data.children[p_idx].ptr();
+	}
+	_FORCE_INLINE_ BTTask *get_parent_ptr() const { return data.parent; }
+	BTTask *get_root_ptr() const;
+
 	_FORCE_INLINE_ int get_child_count() const { return data.children.size(); }
 	int get_enabled_child_count() const;
 
@@ -178,4 +248,13 @@ public:
 	~BTTask();
 };
 
+VARIANT_BITFIELD_CAST(BTTask::Capability);
+
+// Declares what the task class may access when executed (see BTTask::Capability).
+#define TASK_CAPABILITIES(m_caps)                                              \
+protected:                                                                     \
+	virtual uint32_t _get_capabilities() const override { return (m_caps); } \
+                                                                               \
+private:
+
 #endif // BT_TASK_H
@@ -19,15 +19,32 @@ BT::Status BTDynamicSequence::_tick(double p_delta) {
 	Status status = SUCCESS;
 	int i;
 	for (i = 0; i < get_child_count(); i++) {
-		status = get_child(i)->execute(p_delta);
+		status = get_child_ptr(i)->execute(p_delta);
 		if (status != SUCCESS) {
 			break;
 		}
 	}
 	// If the last node ticked is earlier in the tree than the previous runner,
 	// cancel previous runner.
-	if (last_running_idx > i && get_child(last_running_idx)->get_status() == RUNNING) {
-		get_child(last_running_idx)->abort();
+	if (last_running_idx > i && get_child_ptr(last_running_idx)->get_status() == RUNNING) {
+		get_child_ptr(last_running_idx)->abort();
+	}
+	last_running_idx = i;
+	return status;
+}
+
+BT::Status BTDynamicSequence::_resume(Status p_child_status, double p_delta) {
+	if (p_child_status != SUCCESS) {
+		return p_child_status;
+	}
+	// Preceding children are not re-evaluated: the blackboard hasn't changed since the last full update.
+	Status status = SUCCESS;
+	int i;
+	for (i = last_running_idx + 1; i < get_child_count(); i++) {
+		status = get_child_ptr(i)->execute(p_delta);
+		if (status != SUCCESS) {
+			break;
+		}
 	}
 	last_running_idx = i;
 	return status;
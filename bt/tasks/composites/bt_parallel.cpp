@@ -13,7 +13,7 @@
 
 void BTParallel::_enter() {
 	for (int i = 0; i < get_child_count(); i++) {
-		get_child(i)->abort();
+		get_child_ptr(i)->abort();
 	}
 }
 
@@ -23,7 +23,7 @@ BT::Status BTParallel::_tick(double p_delta) {
 	BT::Status return_status = RUNNING;
 	for (int i = 0; i < get_child_count(); i++) {
 		Status status = BT::FRESH;
-		Ref<BTTask> child = get_child(i);
+		BTTask *child = get_child_ptr(i);
 		if (!repeat && (child->get_status() == FAILURE || child->get_status() == SUCCESS)) {
 			status = child->get_status();
 		} else {
@@ -17,6 +17,7 @@
 class BTParallel : public BTComposite {
 	GDCLASS(BTParallel, BTComposite);
 	TASK_CATEGORY(Composites);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	int num_successes_required = 1;
@@ -63,22 +63,26 @@ bool BTProbabilitySelector::get_abort_on_failure() const {
 }
 
 void BTProbabilitySelector::_enter() {
+	failed_tasks.resize(get_child_count());
+	for (uint32_t i = 0; i < failed_tasks.size(); i++) {
+		failed_tasks[i] = false;
+	}
 	_select_task();
 }
 
 void BTProbabilitySelector::_exit() {
 	failed_tasks.clear();
-	selected_task.unref();
+	selected_index = -1;
 }
 
 BT::Status BTProbabilitySelector::_tick(double p_delta) {
-	while (selected_task.is_valid()) {
-		Status status = selected_task->execute(p_delta);
+	while (selected_index != -1) {
+		Status status = get_child_ptr(selected_index)->execute(p_delta);
 		if (status == FAILURE) {
 			if (abort_on_failure) {
 				return FAILURE;
 			}
-			failed_tasks.insert(selected_task);
+			failed_tasks[selected_index] = true;
 			_select_task();
 		} else { // RUNNING or SUCCESS
 			return status;
@@ -89,17 +93,18 @@ BT::Status BTProbabilitySelector::_tick(double p_delta) {
 }
 
 void BTProbabilitySelector::_select_task() {
-	selected_task.unref();
+	selected_index = -1;
 
 	double remaining_tasks_weight = _get_total_weight();
-	for (const Ref<BTTask> &task : failed_tasks) {
-		remaining_tasks_weight -= _get_weight(task);
+	for (uint32_t i = 0; i < failed_tasks.size(); i++) {
+		if (failed_tasks[i]) {
+			remaining_tasks_weight -= _get_weight(i);
+		}
 	}
 
 	double roll = RAND_RANGE(0.0, remaining_tasks_weight);
 	for (int i = 0; i < get_child_count(); i++) {
-		Ref<BTTask> task = get_child(i);
-		if (failed_tasks.has(task)) {
+		if (failed_tasks[i]) {
 			continue;
 		}
 		double weight = _get_weight(i);
@@ -111,7 +116,7 @@ void BTProbabilitySelector::_select_task() {
 			continue;
 		}
 
-		selected_task = task;
+		selected_index = i;
 		break;
 	}
 }
@@ -16,25 +16,25 @@
 #include "../bt_composite.h"
 
 #ifdef LIMBOAI_MODULE
-#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
-#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
 class BTProbabilitySelector : public BTComposite {
 	GDCLASS(BTProbabilitySelector, BTComposite);
 	TASK_CATEGORY(Composites);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
-	HashSet<Ref<BTTask>> failed_tasks;
-	Ref<BTTask> selected_task;
+	LocalVector<bool> failed_tasks; // indexed by child
+	int selected_index = -1;
 	bool abort_on_failure = false;
 
 	void _select_task();
-	_FORCE_INLINE_ double _get_weight(int p_index) const { return get_child(p_index)->get_meta(LW_NAME(_weight_), 1.0); }
-	_FORCE_INLINE_ double _get_weight(Ref<BTTask> p_task) const { return p_task->get_meta(LW_NAME(_weight_), 1.0); }
+	_FORCE_INLINE_ double _get_weight(int p_index) const { return get_child_ptr(p_index)->get_meta(LW_NAME(_weight_), 1.0); }
 	_FORCE_INLINE_ void _set_weight(int p_index, double p_weight) {
 		get_child(p_index)->set_meta(LW_NAME(_weight_), Variant(p_weight));
 		get_child(p_index)->emit_signal(LW_NAME(changed));
@@ -42,7 +42,7 @@ private:
 	_FORCE_INLINE_ double _get_total_weight() const {
 		double total = 0.0;
 		for (int i = 0; i < get_child_count(); i++) {
-			if (get_child(i)->is_enabled()) {
+			if (get_child_ptr(i)->is_enabled()) {
 				total += _get_weight(i);
 			}
 		}
@@ -17,6 +17,7 @@
 class BTRandomSelector : public BTComposite {
 	GDCLASS(BTRandomSelector, BTComposite);
 	TASK_CATEGORY(Composites);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	int last_running_idx = 0;
@@ -27,6 +28,9 @@ protected:
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+
+	virtual bool _is_resumable() const override { return true; }
+	virtual Status _resume(Status p_child_status, double p_delta) override;
 };
 
 #endif // BT_RANDOM_SELECTOR_H
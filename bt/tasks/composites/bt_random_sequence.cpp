@@ -25,7 +25,7 @@ void BTRandomSequence::_enter() {
 BT::Status BTRandomSequence::_tick(double p_delta) {
 	Status status = SUCCESS;
 	for (int i = last_running_idx; i < get_child_count(); i++) {
-		status = get_child(indicies[i])->execute(p_delta);
+		status = get_child_ptr(indicies[i])->execute(p_delta);
 		if (status != SUCCESS) {
 			last_running_idx = i;
 			break;
@@ -33,3 +33,11 @@ BT::Status BTRandomSequence::_tick(double p_delta) {
 	}
 	return status;
 }
+
+BT::Status BTRandomSequence::_resume(Status p_child_status, double p_delta) {
+	if (p_child_status != SUCCESS) {
+		return p_child_status;
+	}
+	last_running_idx += 1;
+	return _tick(p_delta);
+}
@@ -18,7 +18,7 @@ void BTSelector::_enter() {
 BT::Status BTSelector::_tick(double p_delta) {
 	Status status = FAILURE;
 	for (int i = last_running_idx; i < get_child_count(); i++) {
-		status = get_child(i)->execute(p_delta);
+		status = get_child_ptr(i)->execute(p_delta);
 		if (status != FAILURE) {
 			last_running_idx = i;
 			break;
@@ -26,3 +26,11 @@ BT::Status BTSelector::_tick(double p_delta) {
 	}
 	return status;
 }
+
+BT::Status BTSelector::_resume(Status p_child_status, double p_delta) {
+	if (p_child_status != FAILURE) {
+		return p_child_status;
+	}
+	last_running_idx += 1;
+	return _tick(p_delta);
+}
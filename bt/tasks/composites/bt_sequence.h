@@ -17,8 +17,11 @@
 class BTSequence : public BTComposite {
 	GDCLASS(BTSequence, BTComposite);
 	TASK_CATEGORY(Composites);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
+	friend class BTInstance;
+
 	int last_running_idx = 0;
 
 protected:
@@ -26,6 +29,9 @@ protected:
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+
+	virtual bool _is_resumable() const override { return true; }
+	virtual Status _resume(Status p_child_status, double p_delta) override;
 };
 
 #endif // BT_SEQUENCE_H
@@ -12,8 +12,12 @@
 #include "bt_always_succeed.h"
 
 BT::Status BTAlwaysSucceed::_tick(double p_delta) {
-	if (get_child_count() > 0 && get_child(0)->execute(p_delta) == RUNNING) {
+	if (get_child_count() > 0 && get_child_ptr(0)->execute(p_delta) == RUNNING) {
 		return RUNNING;
 	}
 	return SUCCESS;
 }
+
+BT::Status BTAlwaysSucceed::_resume(Status p_child_status, double p_delta) {
+	return p_child_status == RUNNING ? RUNNING : SUCCESS;
+}
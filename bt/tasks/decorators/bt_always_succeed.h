@@ -17,11 +17,15 @@
 class BTAlwaysSucceed : public BTDecorator {
 	GDCLASS(BTAlwaysSucceed, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 protected:
 	static void _bind_methods() {}
 
 	virtual Status _tick(double p_delta) override;
+
+	virtual bool _is_resumable() const override { return true; }
+	virtual Status _resume(Status p_child_status, double p_delta) override;
 };
 
 #endif // BT_ALWAYS_SUCCEED_H
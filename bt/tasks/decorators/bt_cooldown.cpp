@@ -52,6 +52,13 @@ String BTCooldown::_generate_name() {
 }
 
 void BTCooldown::_setup() {
+	// A pooled instance may be initialized again while the timer of the previous binding is running.
+	if (timer.is_valid()) {
+		if (timer->is_connected(LW_NAME(timeout), callable_mp(this, &BTCooldown::_on_timeout))) {
+			timer->disconnect(LW_NAME(timeout), callable_mp(this, &BTCooldown::_on_timeout));
+		}
+		timer.unref();
+	}
 	if (cooldown_state_var == StringName()) {
 		cooldown_state_var = vformat("cooldown_%d", get_instance_id());
 	}
@@ -66,7 +73,7 @@ BT::Status BTCooldown::_tick(double p_delta) {
 	if (get_blackboard()->get_var(cooldown_state_var, true)) {
 		return FAILURE;
 	}
-	Status status = get_child(0)->execute(p_delta);
+	Status status = get_child_ptr(0)->execute(p_delta);
 	if (status == SUCCESS || (trigger_on_failure && status == FAILURE)) {
 		_chill();
 	}
@@ -25,6 +25,7 @@
 class BTCooldown : public BTDecorator {
 	GDCLASS(BTCooldown, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_WRITES_SCENE);
 
 private:
 	double duration = 10.0;
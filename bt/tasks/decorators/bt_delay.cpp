@@ -25,7 +25,7 @@ BT::Status BTDelay::_tick(double p_delta) {
 	if (get_elapsed_time() <= seconds) {
 		return RUNNING;
 	}
-	return get_child(0)->execute(p_delta);
+	return get_child_ptr(0)->execute(p_delta);
 }
 
 void BTDelay::_bind_methods() {
@@ -17,6 +17,7 @@
 class BTDelay : public BTDecorator {
 	GDCLASS(BTDelay, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	double seconds = 1.0;
@@ -17,6 +17,7 @@
 class BTForEach : public BTDecorator {
 	GDCLASS(BTForEach, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	StringName array_var;
@@ -19,6 +19,7 @@
 class BTNewScope : public BTDecorator {
 	GDCLASS(BTNewScope, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	Ref<BlackboardPlan> blackboard_plan;
@@ -32,10 +33,14 @@ protected:
 
 	virtual void _update_blackboard_plan() {}
 
+	// Blackboard plan is updated when assigned, so it can't be shared.
+	virtual bool _can_share_sub_resources() const override { return false; }
+
 	void set_blackboard_plan(const Ref<BlackboardPlan> &p_plan);
 	Ref<BlackboardPlan> get_blackboard_plan() const { return blackboard_plan; }
 
 	virtual Status _tick(double p_delta) override;
+	virtual bool _is_resumable() const override { return true; }
 
 public:
 	virtual void initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root) override;
@@ -24,8 +24,8 @@ String BTProbability::_generate_name() {
 
 BT::Status BTProbability::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator has no child.");
-	if (get_child(0)->get_status() == RUNNING || RANDF() <= run_chance) {
-		return get_child(0)->execute(p_delta);
+	if (get_child_ptr(0)->get_status() == RUNNING || RANDF() <= run_chance) {
+		return get_child_ptr(0)->execute(p_delta);
 	}
 	return FAILURE;
 }
@@ -17,6 +17,7 @@
 class BTProbability : public BTDecorator {
 	GDCLASS(BTProbability, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	float run_chance = 0.5;
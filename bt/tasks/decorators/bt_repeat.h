@@ -17,6 +17,7 @@
 class BTRepeat : public BTDecorator {
 	GDCLASS(BTRepeat, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	bool forever = false;
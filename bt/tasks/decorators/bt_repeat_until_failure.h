@@ -17,6 +17,7 @@
 class BTRepeatUntilFailure : public BTDecorator {
 	GDCLASS(BTRepeatUntilFailure, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 protected:
 	static void _bind_methods() {}
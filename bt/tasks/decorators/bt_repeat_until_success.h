@@ -17,6 +17,7 @@
 class BTRepeatUntilSuccess : public BTDecorator {
 	GDCLASS(BTRepeatUntilSuccess, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 protected:
 	static void _bind_methods() {}
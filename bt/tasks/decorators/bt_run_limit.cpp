@@ -30,7 +30,7 @@ BT::Status BTRunLimit::_tick(double p_delta) {
 	if (num_runs >= run_limit) {
 		return FAILURE;
 	}
-	Status child_status = get_child(0)->execute(p_delta);
+	Status child_status = get_child_ptr(0)->execute(p_delta);
 	if ((count_policy == COUNT_SUCCESSFUL && child_status == SUCCESS) ||
 			(count_policy == COUNT_FAILED && child_status == FAILURE) ||
 			(count_policy == COUNT_ALL && child_status != RUNNING)) {
@@ -17,6 +17,7 @@
 class BTRunLimit : public BTDecorator {
 	GDCLASS(BTRunLimit, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 public:
 	enum CountPolicy {
@@ -34,6 +35,7 @@ protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override { num_runs = 0; }
 	virtual Status _tick(double p_delta) override;
 
 public:
@@ -56,18 +56,29 @@ String BTSubtree::_generate_name() {
 }
 
 void BTSubtree::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root) {
-	ERR_FAIL_COND_MSG(!subtree.is_valid(), "Subtree is not assigned.");
-	ERR_FAIL_COND_MSG(!subtree->get_root_task().is_valid(), "Subtree root task is not valid.");
-	ERR_FAIL_COND_MSG(get_child_count() != 0, "Subtree task shouldn't have children during initialization.");
+	if (!subtree_instantiated) {
+		ERR_FAIL_COND_MSG(!subtree.is_valid(), "Subtree is not assigned.");
+		ERR_FAIL_COND_MSG(!subtree->get_root_task().is_valid(), "Subtree root task is not valid.");
+		ERR_FAIL_COND_MSG(get_child_count() != 0, "Subtree task shouldn't have children during initialization.");
 
-	add_child(subtree->get_root_task()->clone());
+		add_child(subtree->clone_root_task());
+		subtree_instantiated = true;
+	}
 
 	BTNewScope::initialize(p_agent, p_blackboard, p_scene_root);
 }
 
+uint32_t BTSubtree::_get_capabilities() const {
+	// Before initialization, the subtree's tasks are not yet children of this task.
+	if (get_child_count() == 0 && subtree.is_valid() && subtree->get_root_task().is_valid()) {
+		return subtree->get_root_task()->get_branch_capabilities();
+	}
+	return CAPABILITY_PURE;
+}
+
 BT::Status BTSubtree::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(get_child_count() == 0, FAILURE, "BT decorator doesn't have a child.");
-	return get_child(0)->execute(p_delta);
+	return get_child_ptr(0)->execute(p_delta);
 }
 
 PackedStringArray BTSubtree::get_configuration_warnings() {
@@ -22,6 +22,8 @@ class BTSubtree : public BTNewScope {
 
 private:
 	Ref<BehaviorTree> subtree;
+	// Set once the subtree is added as the child, so that pooled instances can be initialized again.
+	bool subtree_instantiated = false;
 
 protected:
 	static void _bind_methods();
@@ -30,6 +32,7 @@ protected:
 
 	virtual String _generate_name() override;
 	virtual Status _tick(double p_delta) override;
+	virtual uint32_t _get_capabilities() const override;
 
 public:
 	void set_subtree(const Ref<BehaviorTree> &p_value);
@@ -17,6 +17,7 @@
 class BTTimeLimit : public BTDecorator {
 	GDCLASS(BTTimeLimit, BTDecorator);
 	TASK_CATEGORY(Decorators);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	double time_limit = 5.0;
@@ -27,6 +27,7 @@
 class BTAwaitAnimation : public BTAction {
 	GDCLASS(BTAwaitAnimation, BTAction);
 	TASK_CATEGORY(Scene);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE);
 
 private:
 	Ref<BBNode> animation_player_param;
@@ -20,6 +20,7 @@
 class BTCheckAgentProperty : public BTCondition {
 	GDCLASS(BTCheckAgentProperty, BTCondition);
 	TASK_CATEGORY(Scene);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE);
 
 private:
 	StringName property;
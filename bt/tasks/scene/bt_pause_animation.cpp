@@ -11,6 +11,7 @@
 
 #include "bt_pause_animation.h"
 
+#include "../../../util/limbo_command_buffer.h"
 #include "../../../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
@@ -63,7 +64,12 @@ void BTPauseAnimation::_setup() {
 
 BT::Status BTPauseAnimation::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(setup_failed == true, FAILURE, "BTPauseAnimation: _setup() failed - returning FAILURE.");
-	animation_player->pause();
+	LimboCommandBuffer *command_buffer = LimboCommandBuffer::get_active();
+	if (command_buffer) {
+		command_buffer->call_method(animation_player, LW_NAME(pause));
+	} else {
+		animation_player->pause();
+	}
 	return SUCCESS;
 }
 
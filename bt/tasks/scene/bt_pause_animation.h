@@ -27,6 +27,7 @@
 class BTPauseAnimation : public BTAction {
 	GDCLASS(BTPauseAnimation, BTAction);
 	TASK_CATEGORY(Scene);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE | CAPABILITY_WRITES_SCENE);
 
 private:
 	Ref<BBNode> animation_player_param;
@@ -11,6 +11,7 @@
 
 #include "bt_play_animation.h"
 
+#include "../../../util/limbo_command_buffer.h"
 #include "../../../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
@@ -99,7 +100,20 @@ void BTPlayAnimation::_setup() {
 }
 
 void BTPlayAnimation::_enter() {
-	if (!setup_failed) {
+	play_deferred = false;
+	if (setup_failed) {
+		return;
+	}
+	LimboCommandBuffer *command_buffer = LimboCommandBuffer::get_active();
+	if (command_buffer) {
+		Array play_args;
+		play_args.push_back(animation_name);
+		play_args.push_back(blend);
+		play_args.push_back(speed);
+		play_args.push_back(from_end);
+		command_buffer->call_method(animation_player, LW_NAME(play), play_args);
+		play_deferred = true;
+	} else {
 		animation_player->play(animation_name, blend, speed, from_end);
 	}
 }
@@ -107,6 +121,12 @@ void BTPlayAnimation::_enter() {
 BT::Status BTPlayAnimation::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(setup_failed == true, FAILURE, "BTPlayAnimation: _setup() failed - returning FAILURE.");
 
+	// Playback starts when the command buffer is flushed after this update.
+	if (play_deferred) {
+		play_deferred = false;
+		return await_completion > 0.0 ? RUNNING : SUCCESS;
+	}
+
 	// ! Doing this check instead of using signal due to a bug in Godot: https://github.com/godotengine/godot/issues/76127
 	if (animation_player->is_playing() && animation_player->get_assigned_animation() == animation_name) {
 		if (get_elapsed_time() < await_completion) {
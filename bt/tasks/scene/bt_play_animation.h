@@ -27,6 +27,7 @@
 class BTPlayAnimation : public BTAction {
 	GDCLASS(BTPlayAnimation, BTAction);
 	TASK_CATEGORY(Scene);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE | CAPABILITY_WRITES_SCENE);
 
 private:
 	Ref<BBNode> animation_player_param;
@@ -38,6 +39,7 @@ private:
 
 	AnimationPlayer *animation_player = nullptr;
 	bool setup_failed = false;
+	bool play_deferred = false;
 
 protected:
 	static void _bind_methods();
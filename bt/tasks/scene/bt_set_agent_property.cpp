@@ -11,6 +11,8 @@
 
 #include "bt_set_agent_property.h"
 
+#include "../../../compat/object.h"
+#include "../../../util/limbo_command_buffer.h"
 #include "../../../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
@@ -72,19 +74,31 @@ BT::Status BTSetAgentProperty::_tick(double p_delta) {
 	Variant right_value = value->get_value(get_scene_root(), get_blackboard(), error_value);
 	ERR_FAIL_COND_V_MSG(right_value == Variant(error_value), FAILURE, "BTSetAgentProperty: Couldn't get value of value-parameter.");
 	bool r_valid;
+	LimboCommandBuffer *command_buffer = LimboCommandBuffer::get_active();
 	if (operation == LimboUtility::OPERATION_NONE) {
 		result = right_value;
 	} else {
+		// A pending write of the property is newer than the agent's value.
+		Variant left_value;
+		if (command_buffer == nullptr || !command_buffer->get_property(get_agent(), property, left_value)) {
 #ifdef LIMBOAI_MODULE
-		Variant left_value = get_agent()->get(property, &r_valid);
-		ERR_FAIL_COND_V_MSG(!r_valid, FAILURE, vformat("BTSetAgentProperty: Failed to get agent's \"%s\" property. Returning FAILURE.", property));
+			left_value = get_agent()->get(property, &r_valid);
+			ERR_FAIL_COND_V_MSG(!r_valid, FAILURE, vformat("BTSetAgentProperty: Failed to get agent's \"%s\" property. Returning FAILURE.", property));
 #elif LIMBOAI_GDEXTENSION
-		Variant left_value = get_agent()->get(property);
+			left_value = get_agent()->get(property);
 #endif
+		}
 		result = LimboUtility::get_singleton()->perform_operation(operation, left_value, right_value);
 		ERR_FAIL_COND_V_MSG(result == Variant(), FAILURE, "BTSetAgentProperty: Operation not valid. Returning FAILURE.");
 	}
 
+	if (command_buffer) {
+		// The write is applied later, so a missing property is reported now, as it would be with a direct write.
+		ERR_FAIL_COND_V_MSG(!OBJECT_HAS_PROPERTY(get_agent(), property), FAILURE, vformat("BTSetAgentProperty: Couldn't set property \"%s\" with value \"%s\"", property, result));
+		command_buffer->set_property(get_agent(), property, result);
+		return SUCCESS;
+	}
+
 #ifdef LIMBOAI_MODULE
 	get_agent()->set(property, result, &r_valid);
 	ERR_FAIL_COND_V_MSG(!r_valid, FAILURE, vformat("BTSetAgentProperty: Couldn't set property \"%s\" with value \"%s\"", property, result));
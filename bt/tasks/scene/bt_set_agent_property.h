@@ -20,6 +20,7 @@
 class BTSetAgentProperty : public BTAction {
 	GDCLASS(BTSetAgentProperty, BTAction);
 	TASK_CATEGORY(Scene);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE | CAPABILITY_WRITES_SCENE);
 
 private:
 	StringName property;
@@ -11,6 +11,7 @@
 
 #include "bt_stop_animation.h"
 
+#include "../../../util/limbo_command_buffer.h"
 #include "../../../util/limbo_string_names.h"
 
 #ifdef LIMBOAI_MODULE
@@ -78,8 +79,25 @@ void BTStopAnimation::_setup() {
 
 BT::Status BTStopAnimation::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(setup_failed == true, FAILURE, "BTStopAnimation: _setup() failed - returning FAILURE.");
-	if (animation_player->is_playing() && (animation_name == StringName() || animation_name == animation_player->get_assigned_animation())) {
-		animation_player->stop(keep_state);
+	LimboCommandBuffer *command_buffer = LimboCommandBuffer::get_active();
+	bool playing = animation_player->is_playing();
+	StringName current_animation = animation_player->get_assigned_animation();
+	Array play_args;
+	if (command_buffer && command_buffer->get_last_call(animation_player, LW_NAME(play), play_args)) {
+		// A playback recorded earlier in this update isn't started yet.
+		playing = true;
+		if (play_args.size() > 0 && StringName(play_args[0]) != StringName()) {
+			current_animation = play_args[0];
+		}
+	}
+	if (playing && (animation_name == StringName() || animation_name == current_animation)) {
+		if (command_buffer) {
+			Array stop_args;
+			stop_args.push_back(keep_state);
+			command_buffer->call_method(animation_player, LW_NAME(stop), stop_args);
+		} else {
+			animation_player->stop(keep_state);
+		}
 	}
 	return SUCCESS;
 }
@@ -27,6 +27,7 @@
 class BTStopAnimation : public BTAction {
 	GDCLASS(BTStopAnimation, BTAction);
 	TASK_CATEGORY(Scene);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE | CAPABILITY_WRITES_SCENE);
 
 private:
 	Ref<BBNode> animation_player_param;
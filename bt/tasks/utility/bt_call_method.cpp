@@ -12,6 +12,7 @@
 #include "bt_call_method.h"
 
 #include "../../../compat/resource.h"
+#include "../../../util/limbo_command_buffer.h"
 #include "../../../util/limbo_string_names.h"
 #include "../../../util/limbo_utility.h"
 
@@ -28,6 +29,7 @@
 
 void BTCallMethod::set_method(const StringName &p_method_name) {
 	method = p_method_name;
+	validated_object_id = 0;
 	emit_changed();
 }
 
@@ -42,11 +44,13 @@ void BTCallMethod::set_node_param(const Ref<BBNode> &p_object) {
 
 void BTCallMethod::set_include_delta(bool p_include_delta) {
 	include_delta = p_include_delta;
+	validated_object_id = 0;
 	emit_changed();
 }
 
 void BTCallMethod::set_args(TypedArray<BBVariant> p_args) {
 	args = p_args;
+	validated_object_id = 0;
 	emit_changed();
 }
 
@@ -57,6 +61,45 @@ void BTCallMethod::set_result_var(const StringName &p_result_var) {
 
 //**** Task Implementation
 
+namespace {
+
+// Returns false if the object has no such method, or if it doesn't accept the given number of arguments.
+bool _can_call_method(Object *p_object, const StringName &p_method, int p_argument_count) {
+#ifdef LIMBOAI_MODULE
+	List<MethodInfo> methods;
+	p_object->get_method_list(&methods);
+	for (const MethodInfo &mi : methods) {
+		if (mi.name != p_method) {
+			continue;
+		}
+		if (mi.flags & METHOD_FLAG_VARARG) {
+			return true;
+		}
+		const int max_args = mi.arguments.size();
+		const int min_args = max_args - mi.default_arguments.size();
+		return p_argument_count >= min_args && p_argument_count <= max_args;
+	}
+#elif LIMBOAI_GDEXTENSION
+	TypedArray<Dictionary> methods = p_object->get_method_list();
+	for (int i = 0; i < methods.size(); i++) {
+		Dictionary mi = methods[i];
+		if (StringName(mi["name"]) != p_method) {
+			continue;
+		}
+		if (int(mi["flags"]) & METHOD_FLAG_VARARG) {
+			return true;
+		}
+		const int max_args = Array(mi["args"]).size();
+		const int min_args = max_args - Array(mi["default_args"]).size();
+		return p_argument_count >= min_args && p_argument_count <= max_args;
+	}
+#endif // LIMBOAI_MODULE & LIMBOAI_GDEXTENSION
+	// Methods handled dynamically, such as the ones of scripts overriding `_call`, are not listed.
+	return p_object->has_method(p_method);
+}
+
+} // namespace
+
 PackedStringArray BTCallMethod::get_configuration_warnings() {
 	PackedStringArray warnings = BTAction::get_configuration_warnings();
 	if (method == StringName()) {
@@ -96,6 +139,26 @@ BT::Status BTCallMethod::_tick(double p_delta) {
 	Variant result;
 	Array call_args;
 
+	// The call can only be deferred if its result isn't needed.
+	LimboCommandBuffer *command_buffer = LimboCommandBuffer::get_active();
+	if (command_buffer && result_var == StringName()) {
+		// A deferred call can't fail the task, so it's validated now. The result is cached for the object.
+		const int argument_count = include_delta ? args.size() + 1 : args.size();
+		if (obj->get_instance_id() != validated_object_id) {
+			ERR_FAIL_COND_V_MSG(!_can_call_method(obj, method, argument_count), FAILURE, vformat("BTCallMethod: Can't call method \"%s\" on %s with %d argument(s).", method, obj, argument_count));
+			validated_object_id = obj->get_instance_id();
+		}
+		if (include_delta) {
+			call_args.push_back(Variant(p_delta));
+		}
+		for (int i = 0; i < args.size(); i++) {
+			Ref<BBVariant> param = args[i];
+			call_args.push_back(param->get_value(get_scene_root(), get_blackboard()));
+		}
+		command_buffer->call_method(obj, method, call_args);
+		return SUCCESS;
+	}
+
 #ifdef LIMBOAI_MODULE
 	const Variant delta = include_delta ? Variant(p_delta) : Variant();
 	const Variant **argptrs = nullptr;
@@ -20,6 +20,7 @@
 class BTCallMethod : public BTAction {
 	GDCLASS(BTCallMethod, BTAction);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE | CAPABILITY_WRITES_SCENE | CAPABILITY_CALLS_SCRIPTS);
 
 private:
 	StringName method;
@@ -28,6 +29,9 @@ private:
 	bool include_delta = false;
 	StringName result_var;
 
+	// Object for which the deferred call was last validated (see _tick()).
+	uint64_t validated_object_id = 0;
+
 protected:
 	static void _bind_methods();
 
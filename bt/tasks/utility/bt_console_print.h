@@ -17,6 +17,7 @@
 class BTConsolePrint : public BTAction {
 	GDCLASS(BTConsolePrint, BTAction);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_MAIN_THREAD);
 
 private:
 	String text;
@@ -28,6 +28,7 @@
 class BTEvaluateExpression : public BTAction {
 	GDCLASS(BTEvaluateExpression, BTAction);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_READS_SCENE | CAPABILITY_WRITES_SCENE | CAPABILITY_CALLS_SCRIPTS);
 
 private:
 	Ref<Expression> expression;
@@ -17,6 +17,7 @@
 class BTFail : public BTAction {
 	GDCLASS(BTFail, BTAction);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 protected:
 	static void _bind_methods() {}
@@ -17,6 +17,7 @@
 class BTRandomWait : public BTAction {
 	GDCLASS(BTRandomWait, BTAction);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	double min_duration = 1.0;
@@ -17,6 +17,7 @@
 class BTWait : public BTAction {
 	GDCLASS(BTWait, BTAction);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	double duration = 1.0;
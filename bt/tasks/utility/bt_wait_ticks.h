@@ -17,6 +17,7 @@
 class BTWaitTicks : public BTAction {
 	GDCLASS(BTWaitTicks, BTAction);
 	TASK_CATEGORY(Utility);
+	TASK_CAPABILITIES(CAPABILITY_PURE);
 
 private:
 	int num_ticks = 1;
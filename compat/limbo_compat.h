@@ -23,11 +23,13 @@
 // *** API abstractions: Module edition
 
 #include "core/io/resource_saver.h"
+#include "core/os/thread.h"
 
 #define RESOURCE_SAVE(m_res, m_path, m_flags) ResourceSaver::save(m_res, m_path, m_flags)
 #define FILE_EXISTS(m_path) FileAccess::exists(m_path)
 #define DIR_ACCESS_CREATE() DirAccess::create(DirAccess::ACCESS_RESOURCES)
 #define ADD_STYLEBOX_OVERRIDE(m_control, m_name, m_stylebox) (m_control->add_theme_style_override(m_name, m_stylebox))
+#define IS_MAIN_THREAD() (Thread::is_main_thread())
 
 // * Enum
 
@@ -41,10 +43,13 @@
 
 // *** API abstractions: GDExtension edition
 
+#include <godot_cpp/classes/os.hpp>
+
 #define RESOURCE_SAVE(m_res, m_path, m_flags) ResourceSaver::get_singleton()->save(m_res, m_path, m_flags)
 #define FILE_EXISTS(m_path) FileAccess::file_exists(m_path)
 #define DIR_ACCESS_CREATE() DirAccess::open("res://")
 #define ADD_STYLEBOX_OVERRIDE(m_control, m_name, m_stylebox) (m_control->add_theme_stylebox_override(m_name, m_stylebox))
+#define IS_MAIN_THREAD() (OS::get_singleton()->get_thread_caller_id() == OS::get_singleton()->get_main_thread_id())
 
 // * Enum
 
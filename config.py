@@ -99,6 +99,7 @@ def get_doc_classes():
         "BTRepeatUntilFailure",
         "BTRepeatUntilSuccess",
         "BTRunLimit",
+        "BTScheduler",
         "BTSelector",
         "BTSequence",
         "BTSetAgentProperty",
@@ -22,18 +22,12 @@ Array BehaviorTreeData::serialize(const Ref<BTInstance> &p_instance) {
 	arr.push_back(uint64_t(p_instance->get_instance_id()));
 	arr.push_back(p_instance->get_owner_node() ? p_instance->get_owner_node()->get_path() : NodePath());
 	arr.push_back(p_instance->get_source_bt_path());
+	arr.push_back(p_instance->is_profiling_tasks());
 
-	// Flatten tree into list depth first
-	List<Ref<BTTask>> stack;
-	stack.push_back(p_instance->get_root_task());
-	while (stack.size()) {
-		Ref<BTTask> task = stack.front()->get();
-		stack.pop_front();
-
+	// Task table is already flattened depth first.
+	for (int i = 0; i < p_instance->get_task_count(); i++) {
+		BTTask *task = p_instance->get_task_entry(i).task;
 		int num_children = task->get_child_count();
-		for (int i = 0; i < num_children; i++) {
-			stack.push_front(task->get_child(num_children - 1 - i));
-		}
 
 		String script_path;
 		if (task->get_script()) {
@@ -49,25 +43,37 @@ Array BehaviorTreeData::serialize(const Ref<BTInstance> &p_instance) {
 		arr.push_back(task->get_elapsed_time());
 		arr.push_back(task->get_class());
 		arr.push_back(script_path);
+
+		LimboTaskProfiler::Stats stats;
+#ifdef DEBUG_ENABLED
+		if (const LimboTaskProfiler::Stats *s = p_instance->get_task_stats(i)) {
+			stats = *s;
+		}
+#endif
+		arr.push_back(stats.calls);
+		arr.push_back(stats.inclusive_usec);
+		arr.push_back(stats.exclusive_usec);
 	}
 
 	return arr;
 }
 
 Ref<BehaviorTreeData> BehaviorTreeData::deserialize(const Array &p_array) {
-	ERR_FAIL_COND_V(p_array.size() < 3, nullptr);
+	ERR_FAIL_COND_V(p_array.size() < 4, nullptr);
 	ERR_FAIL_COND_V(p_array[0].get_type() != Variant::INT, nullptr);
 	ERR_FAIL_COND_V(p_array[1].get_type() != Variant::NODE_PATH, nullptr);
 	ERR_FAIL_COND_V(p_array[2].get_type() != Variant::STRING, nullptr);
+	ERR_FAIL_COND_V(p_array[3].get_type() != Variant::BOOL, nullptr);
 
 	Ref<BehaviorTreeData> data = memnew(BehaviorTreeData);
 	data->bt_instance_id = uint64_t(p_array[0]);
 	data->node_owner_path = p_array[1];
 	data->source_bt_path = p_array[2];
+	data->is_profiled = p_array[3];
 
-	int idx = 3;
+	int idx = 4;
 	while (p_array.size() > idx + 1) {
-		ERR_FAIL_COND_V(p_array.size() < idx + 7, nullptr);
+		ERR_FAIL_COND_V(p_array.size() < idx + 11, nullptr);
 		ERR_FAIL_COND_V(p_array[idx].get_type() != Variant::INT, nullptr);
 		ERR_FAIL_COND_V(p_array[idx + 1].get_type() != Variant::STRING, nullptr);
 		ERR_FAIL_COND_V(p_array[idx + 2].get_type() != Variant::BOOL, nullptr);
@@ -76,8 +82,12 @@ Ref<BehaviorTreeData> BehaviorTreeData::deserialize(const Array &p_array) {
 		ERR_FAIL_COND_V(p_array[idx + 5].get_type() != Variant::FLOAT, nullptr);
 		ERR_FAIL_COND_V(p_array[idx + 6].get_type() != Variant::STRING, nullptr);
 		ERR_FAIL_COND_V(p_array[idx + 7].get_type() != Variant::STRING, nullptr);
-		data->tasks.push_back(TaskData(p_array[idx], p_array[idx + 1], p_array[idx + 2], p_array[idx + 3], p_array[idx + 4], p_array[idx + 5], p_array[idx + 6], p_array[idx + 7]));
-		idx += 8;
+		ERR_FAIL_COND_V(p_array[idx + 8].get_type() != Variant::INT, nullptr);
+		ERR_FAIL_COND_V(p_array[idx + 9].get_type() != Variant::INT, nullptr);
+		ERR_FAIL_COND_V(p_array[idx + 10].get_type() != Variant::INT, nullptr);
+		data->tasks.push_back(TaskData(p_array[idx], p_array[idx + 1], p_array[idx + 2], p_array[idx + 3], p_array[idx + 4], p_array[idx + 5], p_array[idx + 6], p_array[idx + 7],
+				uint64_t(p_array[idx + 8]), uint64_t(p_array[idx + 9]), uint64_t(p_array[idx + 10])));
+		idx += 11;
 	}
 
 	return data;
@@ -91,18 +101,12 @@ Ref<BehaviorTreeData> BehaviorTreeData::create_from_bt_instance(const Ref<BTInst
 	data->bt_instance_id = p_bt_instance->get_instance_id();
 	data->node_owner_path = p_bt_instance->get_owner_node() ? p_bt_instance->get_owner_node()->get_path() : NodePath();
 	data->source_bt_path = p_bt_instance->get_source_bt_path();
+	data->is_profiled = p_bt_instance->is_profiling_tasks();
 
-	// Flatten tree into list depth first
-	List<Ref<BTTask>> stack;
-	stack.push_back(p_bt_instance->get_root_task());
-	while (stack.size()) {
-		Ref<BTTask> task = stack.front()->get();
-		stack.pop_front();
-
+	// Task table is already flattened depth first.
+	for (int i = 0; i < p_bt_instance->get_task_count(); i++) {
+		BTTask *task = p_bt_instance->get_task_entry(i).task;
 		int num_children = task->get_child_count();
-		for (int i = 0; i < num_children; i++) {
-			stack.push_front(task->get_child(num_children - 1 - i));
-		}
 
 		String script_path;
 		if (task->get_script()) {
@@ -110,6 +114,13 @@ Ref<BehaviorTreeData> BehaviorTreeData::create_from_bt_instance(const Ref<BTInst
 			script_path = s->get_path();
 		}
 
+		LimboTaskProfiler::Stats stats;
+#ifdef DEBUG_ENABLED
+		if (const LimboTaskProfiler::Stats *s = p_bt_instance->get_task_stats(i)) {
+			stats = *s;
+		}
+#endif
+
 		data->tasks.push_back(TaskData(
 				task->get_instance_id(),
 				task->get_task_name(),
@@ -118,7 +129,10 @@ Ref<BehaviorTreeData> BehaviorTreeData::create_from_bt_instance(const Ref<BTInst
 				task->get_status(),
 				task->get_elapsed_time(),
 				task->get_class(),
-				script_path));
+				script_path,
+				stats.calls,
+				stats.inclusive_usec,
+				stats.exclusive_usec));
 	}
 	return data;
 }
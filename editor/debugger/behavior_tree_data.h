@@ -30,8 +30,12 @@ public:
 		double elapsed_time = 0.0;
 		String type_name;
 		String script_path;
+		// Profiling stats, zero if the instance is not profiled.
+		uint64_t calls = 0;
+		uint64_t inclusive_usec = 0;
+		uint64_t exclusive_usec = 0;
 
-		TaskData(uint64_t p_id, const String &p_name, bool p_is_custom_name, int p_num_children, int p_status, double p_elapsed_time, const String &p_type_name, const String &p_script_path) {
+		TaskData(uint64_t p_id, const String &p_name, bool p_is_custom_name, int p_num_children, int p_status, double p_elapsed_time, const String &p_type_name, const String &p_script_path, uint64_t p_calls = 0, uint64_t p_inclusive_usec = 0, uint64_t p_exclusive_usec = 0) {
 			id = p_id;
 			name = p_name;
 			is_custom_name = p_is_custom_name;
@@ -40,6 +44,9 @@ public:
 			elapsed_time = p_elapsed_time;
 			type_name = p_type_name;
 			script_path = p_script_path;
+			calls = p_calls;
+			inclusive_usec = p_inclusive_usec;
+			exclusive_usec = p_exclusive_usec;
 		}
 
 		TaskData() {}
@@ -49,6 +56,7 @@ public:
 	uint64_t bt_instance_id = 0;
 	NodePath node_owner_path;
 	String source_bt_path;
+	bool is_profiled = false;
 
 public:
 	static Array serialize(const Ref<BTInstance> &p_instance);
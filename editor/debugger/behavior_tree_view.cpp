@@ -16,6 +16,7 @@
 #include "../../bt/tasks/bt_task.h"
 #include "../../compat/editor_scale.h"
 #include "../../compat/editor_settings.h"
+#include "../../compat/translation.h"
 #include "../../util/limbo_string_names.h"
 #include "../../util/limbo_utility.h"
 #include "behavior_tree_data.h"
@@ -100,6 +101,17 @@ inline void _item_set_elapsed_time(TreeItem *p_item, double p_elapsed) {
 	p_item->set_text(2, rtos(Math::snapped(p_elapsed, 0.01)).pad_decimals(2));
 }
 
+inline void _item_set_profile(TreeItem *p_item, const BehaviorTreeData::TaskData &p_task_data) {
+	if (p_task_data.calls == 0) {
+		p_item->set_text(3, String());
+		p_item->set_tooltip_text(3, String());
+		return;
+	}
+	p_item->set_text(3, rtos(Math::snapped(p_task_data.exclusive_usec * 0.001, 0.01)).pad_decimals(2));
+	p_item->set_tooltip_text(3, vformat(TTR("Calls: %d\nInclusive: %s ms\nExclusive: %s ms"), (int64_t)p_task_data.calls,
+			String::num(p_task_data.inclusive_usec * 0.001, 3), String::num(p_task_data.exclusive_usec * 0.001, 3)));
+}
+
 void BehaviorTreeView::update_tree(const Ref<BehaviorTreeData> &p_data) {
 	ERR_FAIL_COND_MSG(p_data.is_null(), "Invalid data. View won't update.");
 	update_data = p_data;
@@ -114,6 +126,9 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 		selected_id = item_get_task_id(tree->get_selected());
 	}
 
+	// Profile column takes space only while the instance is profiled.
+	tree->set_column_custom_minimum_width(3, p_data->is_profiled ? theme_cache.profile_column_width : 0);
+
 	if (last_root_id != 0 && p_data->tasks.size() > 0 && last_root_id == (uint64_t)p_data->tasks.front()->get().id) {
 		// * Update tree.
 		// ! Update routine is built on assumption that the behavior tree does NOT mutate. With little work it could detect mutations.
@@ -147,6 +162,7 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 			if (status_changed || current_status == BTTask::RUNNING) {
 				_item_set_elapsed_time(item, p_data->tasks.get(idx).elapsed_time);
 			}
+			_item_set_profile(item, p_data->tasks.get(idx));
 
 			if (item->get_first_child()) {
 				item = item->get_first_child();
@@ -202,6 +218,9 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 			item->set_text_alignment(2, HORIZONTAL_ALIGNMENT_RIGHT);
 			_item_set_elapsed_time(item, task_data.elapsed_time);
 
+			item->set_text_alignment(3, HORIZONTAL_ALIGNMENT_RIGHT);
+			_item_set_profile(item, task_data);
+
 			String cors = (task_data.script_path.is_empty()) ? task_data.type_name : task_data.script_path;
 			item->set_icon(0, LimboUtility::get_singleton()->get_task_icon(cors));
 			item->set_icon_max_width(0, 16 * _get_editor_scale()); // Force user icon size.
@@ -294,6 +313,7 @@ void BehaviorTreeView::_do_update_theme_item_cache() {
 	int font_size = tree->get_theme_font_size(LW_NAME(font_size));
 	int timings_size = font->get_string_size("00.00", HORIZONTAL_ALIGNMENT_RIGHT, -1, font_size).x + 16 + extra_spacing;
 	tree->set_column_custom_minimum_width(2, timings_size * _get_editor_scale());
+	theme_cache.profile_column_width = (font->get_string_size("000.00", HORIZONTAL_ALIGNMENT_RIGHT, -1, font_size).x + 16 + extra_spacing) * _get_editor_scale();
 }
 
 void BehaviorTreeView::_notification(int p_what) {
@@ -339,10 +359,11 @@ void BehaviorTreeView::_bind_methods() {
 BehaviorTreeView::BehaviorTreeView() {
 	tree = memnew(Tree);
 	add_child(tree);
-	tree->set_columns(3); // task | status icon | elapsed
+	tree->set_columns(4); // task | status icon | elapsed | exclusive time (if profiled)
 	tree->set_column_expand(0, true);
 	tree->set_column_expand(1, false);
 	tree->set_column_expand(2, false);
+	tree->set_column_expand(3, false);
 	tree->set_anchor(SIDE_RIGHT, ANCHOR_END);
 	tree->set_anchor(SIDE_BOTTOM, ANCHOR_END);
 }
@@ -49,6 +49,7 @@ private:
 
 		int tree_inner_margin_top = 0;
 		int tree_inner_margin_bottom = 0;
+		int profile_column_width = 0;
 	} theme_cache;
 
 	Vector<uint64_t> collapsed_ids;
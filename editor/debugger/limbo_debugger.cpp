@@ -71,6 +71,11 @@ Error LimboDebugger::parse_message(void *p_user, const String &p_msg, const Arra
 		singleton->_send_active_bt_players();
 	} else if (p_msg == "stop_session") {
 		singleton->session_active = false;
+		singleton->_set_task_profiling(false);
+	} else if (p_msg == "set_task_profiling") {
+		singleton->_set_task_profiling(p_args[0]);
+	} else if (p_msg == "request_task_profile") {
+		singleton->_send_task_profile();
 	} else {
 		r_captured = false;
 	}
@@ -104,6 +109,9 @@ void LimboDebugger::register_bt_instance(uint64_t p_instance_id) {
 	}
 
 	active_bt_instances.insert(p_instance_id);
+	if (task_profiling) {
+		inst->set_profile_tasks(true);
+	}
 	if (session_active) {
 		_send_active_bt_players();
 	}
@@ -168,6 +176,75 @@ void LimboDebugger::_send_active_bt_players() {
 	EngineDebugger::get_singleton()->send_message("limboai:active_bt_players", arr);
 }
 
+void LimboDebugger::_set_task_profiling(bool p_enable) {
+	if (task_profiling == p_enable) {
+		return;
+	}
+	task_profiling = p_enable;
+	for (uint64_t instance_id : active_bt_instances) {
+		BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(instance_id));
+		if (inst) {
+			inst->set_profile_tasks(p_enable);
+		}
+	}
+}
+
+namespace {
+
+// Flattens stats into [name, calls, inclusive_usec, exclusive_usec, ...].
+Array _task_stats_to_array(const HashMap<String, LimboTaskProfiler::Stats> &p_stats) {
+	Array arr;
+	for (const KeyValue<String, LimboTaskProfiler::Stats> &kv : p_stats) {
+		arr.push_back(kv.key);
+		arr.push_back(kv.value.calls);
+		arr.push_back(kv.value.inclusive_usec);
+		arr.push_back(kv.value.exclusive_usec);
+	}
+	return arr;
+}
+
+} // namespace
+
+void LimboDebugger::_send_task_profile() {
+	// Task stats of profiled instances are aggregated by task type within each tree resource,
+	// and by task type across all trees. Scripted tasks are identified by their script path.
+	HashMap<String, HashMap<String, LimboTaskProfiler::Stats>> tree_totals;
+	HashMap<String, LimboTaskProfiler::Stats> type_totals;
+	for (uint64_t instance_id : active_bt_instances) {
+		BTInstance *inst = Object::cast_to<BTInstance>(OBJECT_DB_GET_INSTANCE(instance_id));
+		if (inst == nullptr || !inst->is_profiling_tasks()) {
+			continue;
+		}
+		HashMap<String, LimboTaskProfiler::Stats> &tree_types = tree_totals[inst->get_source_bt_path()];
+		for (int i = 0; i < inst->get_task_count(); i++) {
+			const LimboTaskProfiler::Stats *stats = inst->get_task_stats(i);
+			if (stats == nullptr || stats->calls == 0) {
+				continue;
+			}
+			BTTask *task = inst->get_task_entry(i).task;
+			String type_name = task->get_class();
+			if (task->get_script()) {
+				Ref<Resource> s = task->get_script();
+				if (!s->get_path().is_empty()) {
+					type_name = s->get_path();
+				}
+			}
+			tree_types[type_name].add(*stats);
+			type_totals[type_name].add(*stats);
+		}
+	}
+
+	Array by_tree;
+	for (const KeyValue<String, HashMap<String, LimboTaskProfiler::Stats>> &kv : tree_totals) {
+		by_tree.push_back(kv.key);
+		by_tree.push_back(_task_stats_to_array(kv.value));
+	}
+	Array arr;
+	arr.push_back(by_tree);
+	arr.push_back(_task_stats_to_array(type_totals));
+	EngineDebugger::get_singleton()->send_message("limboai:task_profile", arr);
+}
+
 void LimboDebugger::_on_bt_instance_updated(int _status, uint64_t p_instance_id) {
 	if (p_instance_id != tracked_instance_id) {
 		return;
@@ -27,6 +27,7 @@
 #ifdef LIMBOAI_MODULE
 #include "core/io/config_file.h"
 #include "core/object/callable_mp.h"
+#include "core/os/time.h"
 #include "editor/docks/filesystem_dock.h"
 #include "scene/gui/separator.h"
 #include "scene/gui/tab_container.h"
@@ -36,6 +37,7 @@
 #include <godot_cpp/classes/config_file.hpp>
 #include <godot_cpp/classes/file_system_dock.hpp>
 #include <godot_cpp/classes/tab_container.hpp>
+#include <godot_cpp/classes/time.hpp>
 #include <godot_cpp/classes/v_separator.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
@@ -49,6 +51,10 @@ void LimboDebuggerTab::_reset_controls() {
 	info_message->show();
 	resource_header->set_disabled(true);
 	resource_header->set_text(TTR("Inactive"));
+	profile_tasks->set_pressed_no_signal(false);
+	task_profile_view->clear();
+	task_profile_view->hide();
+	set_process(false);
 }
 
 void LimboDebuggerTab::start_session() {
@@ -58,6 +64,9 @@ void LimboDebuggerTab::start_session() {
 	info_message->set_text(TTR("Pick a player from the list to display behavior tree."));
 	info_message->show();
 	session->send_message("limboai:start_session", Array());
+	if (profile_tasks->is_pressed()) {
+		_profile_tasks_toggled(true);
+	}
 }
 
 void LimboDebuggerTab::stop_session() {
@@ -89,6 +98,78 @@ void LimboDebuggerTab::update_behavior_tree(const Ref<BehaviorTreeData> &p_data)
 	info_message->hide();
 }
 
+void LimboDebuggerTab::update_task_profile(const Array &p_data) {
+	ERR_FAIL_COND(p_data.size() != 2);
+	const Array by_tree = p_data[0];
+	const Array by_type = p_data[1];
+	ERR_FAIL_COND(by_tree.size() % 2 != 0);
+
+	// Tree totals are computed from exclusive times, which add up to the time spent in a tree.
+	Vector<TaskProfileEntry> trees;
+	HashMap<String, Vector<TaskProfileEntry>> tree_types;
+	for (int i = 0; i < by_tree.size(); i += 2) {
+		TaskProfileEntry tree_entry;
+		tree_entry.name = by_tree[i];
+		Vector<TaskProfileEntry> types = _parse_task_profile_entries(by_tree[i + 1]);
+		for (const TaskProfileEntry &type_entry : types) {
+			tree_entry.calls += type_entry.calls;
+			tree_entry.exclusive_usec += type_entry.exclusive_usec;
+		}
+		tree_entry.inclusive_usec = tree_entry.exclusive_usec;
+		trees.push_back(tree_entry);
+		tree_types[tree_entry.name] = types;
+	}
+	trees.sort_custom<TaskProfileEntrySort>();
+
+	task_profile_view->clear();
+	TreeItem *root = task_profile_view->create_item();
+
+	TreeItem *trees_item = task_profile_view->create_item(root);
+	trees_item->set_text(0, TTR("By Tree"));
+	for (const TaskProfileEntry &tree_entry : trees) {
+		TreeItem *tree_item = _add_task_profile_item(trees_item, tree_entry, "BehaviorTree");
+		for (const TaskProfileEntry &type_entry : tree_types[tree_entry.name]) {
+			_add_task_profile_item(tree_item, type_entry, type_entry.name);
+		}
+	}
+
+	TreeItem *types_item = task_profile_view->create_item(root);
+	types_item->set_text(0, TTR("By Task Type"));
+	for (const TaskProfileEntry &type_entry : _parse_task_profile_entries(by_type)) {
+		_add_task_profile_item(types_item, type_entry, type_entry.name);
+	}
+}
+
+Vector<LimboDebuggerTab::TaskProfileEntry> LimboDebuggerTab::_parse_task_profile_entries(const Array &p_data) const {
+	Vector<TaskProfileEntry> entries;
+	ERR_FAIL_COND_V(p_data.size() % 4 != 0, entries);
+	for (int i = 0; i < p_data.size(); i += 4) {
+		TaskProfileEntry entry;
+		entry.name = p_data[i];
+		entry.calls = uint64_t(p_data[i + 1]);
+		entry.inclusive_usec = uint64_t(p_data[i + 2]);
+		entry.exclusive_usec = uint64_t(p_data[i + 3]);
+		entries.push_back(entry);
+	}
+	entries.sort_custom<TaskProfileEntrySort>();
+	return entries;
+}
+
+TreeItem *LimboDebuggerTab::_add_task_profile_item(TreeItem *p_parent, const TaskProfileEntry &p_entry, const String &p_icon) {
+	TreeItem *item = task_profile_view->create_item(p_parent);
+	item->set_text(0, p_entry.name.begins_with("res://") ? p_entry.name.get_file() : p_entry.name);
+	item->set_tooltip_text(0, p_entry.name);
+	item->set_icon(0, LimboUtility::get_singleton()->get_task_icon(p_icon));
+	item->set_icon_max_width(0, 16 * EDSCALE);
+	item->set_text(1, itos(p_entry.calls));
+	item->set_text(2, String::num(p_entry.inclusive_usec * 0.001, 3));
+	item->set_text(3, String::num(p_entry.exclusive_usec * 0.001, 3));
+	for (int col = 1; col < 4; col++) {
+		item->set_text_alignment(col, HORIZONTAL_ALIGNMENT_RIGHT);
+	}
+	return item;
+}
+
 void LimboDebuggerTab::_show_alert(const String &p_message) {
 	alert_message->set_text(p_message);
 	alert_box->set_visible(!p_message.is_empty());
@@ -165,6 +246,17 @@ void LimboDebuggerTab::_on_task_selected(const String &p_type_name, const String
 	}
 }
 
+void LimboDebuggerTab::_profile_tasks_toggled(bool p_pressed) {
+	task_profile_view->clear();
+	task_profile_view->set_visible(p_pressed);
+	set_process(p_pressed);
+	if (session.is_valid() && session->is_active()) {
+		Array msg_data;
+		msg_data.push_back(p_pressed);
+		session->send_message("limboai:set_task_profiling", msg_data);
+	}
+}
+
 void LimboDebuggerTab::_resource_header_pressed() {
 	String bt_path = resource_header->get_text();
 	if (bt_path.is_empty()) {
@@ -188,6 +280,7 @@ void LimboDebuggerTab::_notification(int p_what) {
 			bt_instance_list->connect(LW_NAME(item_selected), callable_mp(this, &LimboDebuggerTab::_bt_instance_selected));
 			bt_view->connect(LW_NAME(task_selected), callable_mp(this, &LimboDebuggerTab::_on_task_selected));
 			update_interval->connect("value_changed", callable_mp(bt_view, &BehaviorTreeView::set_update_interval_msec));
+			profile_tasks->connect(LW_NAME(toggled), callable_mp(this, &LimboDebuggerTab::_profile_tasks_toggled));
 
 			Ref<ConfigFile> cf;
 			cf.instantiate();
@@ -209,6 +302,14 @@ void LimboDebuggerTab::_notification(int p_what) {
 			alert_icon->set_texture(get_theme_icon(LW_NAME(StatusWarning), LW_NAME(EditorIcons)));
 			resource_header->set_button_icon(LimboUtility::get_singleton()->get_task_icon("BehaviorTree"));
 		} break;
+		case NOTIFICATION_PROCESS: {
+			// Aggregated task profile is polled while profiling is enabled.
+			int ticks_msec = Time::get_singleton()->get_ticks_msec();
+			if ((ticks_msec - last_profile_request_msec) >= 1000 && session->is_active()) {
+				last_profile_request_msec = ticks_msec;
+				session->send_message("limboai:request_task_profile", Array());
+			}
+		} break;
 	}
 }
 
@@ -257,6 +358,14 @@ LimboDebuggerTab::LimboDebuggerTab() {
 	update_interval->set_suffix("ms");
 	update_interval->set_custom_minimum_size(Vector2(100 * EDSCALE, 0));
 
+	profile_tasks = memnew(Button);
+	toolbar->add_child(profile_tasks);
+	profile_tasks->set_toggle_mode(true);
+	profile_tasks->set_flat(true);
+	profile_tasks->set_focus_mode(FOCUS_NONE);
+	profile_tasks->set_text(TTR("Profile Tasks"));
+	profile_tasks->set_tooltip_text(TTR("Measure execution time of each task in running behavior trees.\nTimes are aggregated by tree resource and by task type across all instances."));
+
 	VSeparator *sep = memnew(VSeparator);
 	toolbar->add_child(sep);
 
@@ -286,6 +395,23 @@ LimboDebuggerTab::LimboDebuggerTab() {
 	bt_view->set_v_size_flags(Control::SIZE_EXPAND_FILL);
 	view_box->add_child(bt_view);
 
+	task_profile_view = memnew(Tree);
+	task_profile_view->hide();
+	task_profile_view->set_custom_minimum_size(Size2(0.0, 160.0 * EDSCALE));
+	task_profile_view->set_columns(4); // name | calls | inclusive | exclusive
+	task_profile_view->set_column_titles_visible(true);
+	task_profile_view->set_column_title(0, TTR("Name"));
+	task_profile_view->set_column_title(1, TTR("Calls"));
+	task_profile_view->set_column_title(2, TTR("Inclusive (ms)"));
+	task_profile_view->set_column_title(3, TTR("Exclusive (ms)"));
+	task_profile_view->set_column_expand(0, true);
+	for (int col = 1; col < 4; col++) {
+		task_profile_view->set_column_expand(col, false);
+		task_profile_view->set_column_custom_minimum_width(col, 110 * EDSCALE);
+	}
+	task_profile_view->set_hide_root(true);
+	view_box->add_child(task_profile_view);
+
 	alert_box = memnew(HBoxContainer);
 	alert_box->hide();
 	view_box->add_child(alert_box);
@@ -359,6 +485,8 @@ bool LimboDebuggerPlugin::_capture(const String &p_message, const Array &p_data,
 		if (data->bt_instance_id == tab->get_selected_bt_instance_id()) {
 			tab->update_behavior_tree(data);
 		}
+	} else if (p_message == "limboai:task_profile") {
+		tab->update_task_profile(p_data);
 	} else {
 		captured = false;
 	}
@@ -31,6 +31,7 @@
 #include "scene/gui/panel_container.h"
 #include "scene/gui/split_container.h"
 #include "scene/gui/texture_rect.h"
+#include "scene/gui/tree.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
@@ -45,6 +46,7 @@
 #include <godot_cpp/classes/line_edit.hpp>
 #include <godot_cpp/classes/panel_container.hpp>
 #include <godot_cpp/classes/texture_rect.hpp>
+#include <godot_cpp/classes/tree.hpp>
 #include <godot_cpp/classes/v_box_container.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
@@ -57,6 +59,17 @@ private:
 		String owner_node_path;
 	};
 
+	struct TaskProfileEntry {
+		String name;
+		uint64_t calls = 0;
+		uint64_t inclusive_usec = 0;
+		uint64_t exclusive_usec = 0;
+	};
+
+	struct TaskProfileEntrySort {
+		_FORCE_INLINE_ bool operator()(const TaskProfileEntry &p_a, const TaskProfileEntry &p_b) const { return p_a.exclusive_usec > p_b.exclusive_usec; }
+	};
+
 	Vector<BTInstanceInfo> active_bt_instances;
 	Ref<EditorDebuggerSession> session;
 	VBoxContainer *root_vb = nullptr;
@@ -73,6 +86,9 @@ private:
 	Button *resource_header = nullptr;
 	Button *make_floating = nullptr;
 	EditorSpinSlider *update_interval = nullptr;
+	Button *profile_tasks = nullptr;
+	Tree *task_profile_view = nullptr;
+	int last_profile_request_msec = 0;
 	CompatWindowWrapper *window_wrapper = nullptr;
 
 	void _reset_controls();
@@ -83,6 +99,9 @@ private:
 	void _window_visibility_changed(bool p_visible);
 	void _resource_header_pressed();
 	void _on_task_selected(const String &p_type_name, const String &p_script_path);
+	void _profile_tasks_toggled(bool p_pressed);
+	Vector<TaskProfileEntry> _parse_task_profile_entries(const Array &p_data) const;
+	TreeItem *_add_task_profile_item(TreeItem *p_parent, const TaskProfileEntry &p_entry, const String &p_icon);
 
 protected:
 	static void _bind_methods();
@@ -95,6 +114,7 @@ public:
 	BehaviorTreeView *get_behavior_tree_view() const { return bt_view; }
 	uint64_t get_selected_bt_instance_id();
 	void update_behavior_tree(const Ref<BehaviorTreeData> &p_data);
+	void update_task_profile(const Array &p_data);
 
 	void setup(Ref<EditorDebuggerSession> p_session, CompatWindowWrapper *p_wrapper);
 	LimboDebuggerTab();
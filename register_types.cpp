@@ -50,6 +50,7 @@
 #include "blackboard/blackboard_plan.h"
 #include "bt/behavior_tree.h"
 #include "bt/bt_player.h"
+#include "bt/bt_scheduler.h"
 #include "bt/bt_state.h"
 #include "bt/tasks/blackboard/bt_check_trigger.h"
 #include "bt/tasks/blackboard/bt_check_var.h"
@@ -154,6 +155,7 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_CLASS(BehaviorTree);
 		GDREGISTER_CLASS(BTInstance);
 		GDREGISTER_CLASS(BTPlayer);
+		GDREGISTER_CLASS(BTScheduler);
 		GDREGISTER_CLASS(BTState);
 
 		LIMBO_REGISTER_TASK(BTComment);
@@ -248,6 +250,7 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 #endif
 
 		LimboStringNames::create();
+		BTScheduler::initialize();
 	}
 
 #ifdef TOOLS_ENABLED
@@ -288,6 +291,7 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 void uninitialize_limboai_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
 		LimboDebugger::deinitialize();
+		BTScheduler::finalize();
 		LimboStringNames::free();
 		memdelete(_limbo_utility);
 	}
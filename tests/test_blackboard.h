@@ -1,10 +1,12 @@
 #ifndef TEST_BLACKBOARD_H
 #define TEST_BLACKBOARD_H
 
+#include "core/object/callable_mp.h"
 #include "core/variant/variant.h"
 #include "limbo_test.h"
 
 #include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/blackboard/blackboard_plan.h"
 
 namespace TestBlackboard {
 
@@ -25,6 +27,35 @@ public:
 	}
 };
 
+// Exposes a property through _get()/_set(), so it has no native accessors.
+class TestDynamicPropertyHolder : public RefCounted {
+	GDCLASS(TestDynamicPropertyHolder, RefCounted);
+
+public:
+	int value = 0;
+
+protected:
+	bool _set(const StringName &p_name, const Variant &p_value) {
+		if (p_name == SNAME("dynamic")) {
+			value = p_value;
+			return true;
+		}
+		return false;
+	}
+	bool _get(const StringName &p_name, Variant &r_ret) const {
+		if (p_name == SNAME("dynamic")) {
+			r_ret = value;
+			return true;
+		}
+		return false;
+	}
+	void _get_property_list(List<PropertyInfo> *p_list) const {
+		p_list->push_back(PropertyInfo(Variant::INT, "dynamic"));
+	}
+
+	static void _bind_methods() {}
+};
+
 TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 	Ref<Blackboard> blackboard = memnew(Blackboard);
 
@@ -160,6 +191,128 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 		CHECK_EQ(blackboard->get_var("a", not_found), Variant(7));
 	}
 
+	SUBCASE("Test variable versions") {
+		int64_t version = blackboard->get_var_version("a");
+		blackboard->set_var("a", 1);
+		CHECK_EQ(blackboard->get_var_version("a"), version + 1);
+
+		Ref<Blackboard> child_scope = memnew(Blackboard);
+		child_scope->set_parent(blackboard);
+		blackboard->set_var("a", 2);
+		CHECK_EQ(child_scope->get_var_version("a"), version + 2);
+
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->get_var_version("not_found"), -1);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Test observers") {
+		Ref<CallbackCounter> counter = memnew(CallbackCounter);
+		Callable callback = callable_mp(counter.ptr(), &CallbackCounter::callback_delta);
+		blackboard->add_var_observer("a", callback);
+		blackboard->add_var_observer("a", callback);
+
+		blackboard->set_var("a", 2);
+		CHECK_EQ(counter->num_callbacks, 1);
+		blackboard->set_var("b", Vector2());
+		CHECK_EQ(counter->num_callbacks, 1);
+
+		blackboard->remove_var_observer("a", callback);
+		blackboard->set_var("a", 3);
+		CHECK_EQ(counter->num_callbacks, 1);
+	}
+
+	SUBCASE("Test variable handles") {
+		Ref<Blackboard> child_scope = memnew(Blackboard);
+		child_scope->set_parent(blackboard);
+
+		Blackboard::VarHandle handle;
+		BBVariable *var = child_scope->resolve_var("a", handle);
+		REQUIRE(var != nullptr);
+		CHECK_EQ(handle.depth, 1);
+		CHECK_EQ(var->get_value(), Variant(1));
+		CHECK_EQ(child_scope->resolve_var("a", handle), var);
+
+		// * Writing a parent variable creates it in the local scope, as set_var() does.
+		child_scope->set_var_with_handle("a", 2, handle);
+		CHECK(child_scope->has_local_var("a"));
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(1));
+		var = child_scope->resolve_var("a", handle);
+		REQUIRE(var != nullptr);
+		CHECK_EQ(handle.depth, 0);
+
+		child_scope->set_var_with_handle("a", 3, handle);
+		CHECK_EQ(child_scope->get_var("a", not_found), Variant(3));
+
+		// * Handle is re-resolved when layout of the scope chain changes.
+		child_scope->erase_var("a");
+		var = child_scope->resolve_var("a", handle);
+		REQUIRE(var != nullptr);
+		CHECK_EQ(handle.depth, 1);
+		blackboard->erase_var("a");
+		CHECK(child_scope->resolve_var("a", handle) == nullptr);
+		CHECK_EQ(handle.depth, -1);
+	}
+
+	SUBCASE("Test lookups in nested scopes") {
+		Ref<Blackboard> middle_scope = memnew(Blackboard);
+		Ref<Blackboard> child_scope = memnew(Blackboard);
+		middle_scope->set_parent(blackboard);
+		child_scope->set_parent(middle_scope);
+
+		CHECK_EQ(child_scope->get_var("a", not_found), Variant(1));
+		CHECK(child_scope->has_var("a"));
+		CHECK_FALSE(child_scope->has_var("d"));
+
+		// * Cached lookups pick up variables added or erased along the chain.
+		middle_scope->set_var("a", 10);
+		middle_scope->set_var("d", 4);
+		CHECK_EQ(child_scope->get_var("a", not_found), Variant(10));
+		CHECK(child_scope->has_var("d"));
+
+		middle_scope->erase_var("a");
+		CHECK_EQ(child_scope->get_var("a", not_found), Variant(1));
+		blackboard->set_var("a", 2);
+		CHECK_EQ(child_scope->get_var("a", not_found), Variant(2));
+
+		// * Cached lookups pick up parent changes.
+		Ref<Blackboard> other_scope = memnew(Blackboard);
+		other_scope->set_var("a", 3);
+		middle_scope->set_parent(other_scope);
+		CHECK_EQ(child_scope->get_var("a", not_found), Variant(3));
+		CHECK_FALSE(child_scope->has_var("b"));
+	}
+
+	SUBCASE("Test typed accessors") {
+		blackboard->set_var("f", 1.5);
+		CHECK(blackboard->get_float("f") == doctest::Approx(1.5));
+		blackboard->set_float("f", 2.5);
+		CHECK_EQ(blackboard->get_var("f", not_found), Variant(2.5));
+
+		// * Values of a different type are converted.
+		CHECK(blackboard->get_float("a") == doctest::Approx(1.0));
+		CHECK_EQ(blackboard->get_vector2("b"), Vector2(2, 2));
+
+		// * Missing variables and incompatible types report an error and return the default.
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->get_int("not_found", 7), 7);
+		blackboard->set_var("arr", Array());
+		CHECK(blackboard->get_float("arr", -1.0) == doctest::Approx(-1.0));
+		ERR_PRINT_ON;
+
+		blackboard->set_bool("new_var", true);
+		CHECK_EQ(blackboard->get_var("new_var", not_found), Variant(true));
+
+		// * Typed writes are versioned and notify observers.
+		int64_t version = blackboard->get_var_version("f");
+		Ref<CallbackCounter> counter = memnew(CallbackCounter);
+		blackboard->add_var_observer("f", callable_mp(counter.ptr(), &CallbackCounter::callback_delta));
+		blackboard->set_float("f", 3.5);
+		CHECK_EQ(blackboard->get_var_version("f"), version + 1);
+		CHECK_EQ(counter->num_callbacks, 1);
+		CHECK(blackboard->get_float("f") == doctest::Approx(3.5));
+	}
+
 	SUBCASE("Test linking") {
 		Ref<Blackboard> target_blackboard = memnew(Blackboard);
 
@@ -181,6 +334,259 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 	}
 }
 
+TEST_CASE("[Modules][LimboAI] Test Blackboard bound property accessors") {
+	Ref<Blackboard> blackboard = memnew(Blackboard);
+	blackboard->set_var("a", 0);
+	Variant not_found = "not found";
+
+	SUBCASE("Native accessors are cached") {
+		Ref<TestPropertyHolder> holder = memnew(TestPropertyHolder);
+		blackboard->bind_var_to_property("a", holder.ptr(), "property");
+		CHECK(blackboard->find_var("a")->has_cached_accessors());
+
+		holder->set_property(5);
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(5));
+		blackboard->set_var("a", 6);
+		CHECK_EQ(holder->get_property(), 6);
+		CHECK_EQ(blackboard->get_int("a"), 6);
+	}
+	SUBCASE("Properties without accessors use Object::get/set") {
+		Ref<TestDynamicPropertyHolder> holder = memnew(TestDynamicPropertyHolder);
+		blackboard->bind_var_to_property("a", holder.ptr(), "dynamic");
+		CHECK_FALSE(blackboard->find_var("a")->has_cached_accessors());
+
+		holder->value = 5;
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(5));
+		blackboard->set_var("a", 6);
+		CHECK_EQ(holder->value, 6);
+	}
+	SUBCASE("Cache follows binding changes") {
+		Ref<TestPropertyHolder> holder = memnew(TestPropertyHolder);
+		Ref<TestDynamicPropertyHolder> dynamic_holder = memnew(TestDynamicPropertyHolder);
+		blackboard->bind_var_to_property("a", holder.ptr(), "property");
+		REQUIRE(blackboard->find_var("a")->has_cached_accessors());
+
+		// * Rebinding to a property without accessors drops the cached ones.
+		blackboard->bind_var_to_property("a", dynamic_holder.ptr(), "dynamic");
+		CHECK_FALSE(blackboard->find_var("a")->has_cached_accessors());
+		blackboard->set_var("a", 7);
+		CHECK_EQ(dynamic_holder->value, 7);
+		CHECK_EQ(holder->get_property(), 0);
+
+		// * Unbinding clears the cache, and the variable stores values again.
+		blackboard->bind_var_to_property("a", holder.ptr(), "property");
+		blackboard->unbind_var("a");
+		CHECK_FALSE(blackboard->find_var("a")->has_cached_accessors());
+		blackboard->set_var("a", 8);
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(8));
+		CHECK_EQ(holder->get_property(), 0);
+	}
+	SUBCASE("Freed bound object") {
+		Ref<TestPropertyHolder> holder = memnew(TestPropertyHolder);
+		blackboard->bind_var_to_property("a", holder.ptr(), "property");
+		blackboard->set_var("a", 5);
+		holder.unref();
+
+		// * Cached accessors aren't called on the freed object; the last value written is returned instead.
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(5));
+		blackboard->set_var("a", 6);
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(6));
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] Test BlackboardPlan population") {
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	plan->set_prefetch_nodepath_vars(false);
+	BBVariable speed(Variant::FLOAT);
+	speed.set_value(1.5);
+	plan->add_var("speed", speed);
+
+	Ref<Blackboard> bb = plan->create_blackboard(nullptr);
+	CHECK(bb->get_var("speed") == Variant(1.5));
+
+	SUBCASE("Changes to the plan are picked up") {
+		BBVariable health(Variant::INT);
+		health.set_value(100);
+		plan->add_var("health", health);
+		plan->rename_var("speed", "velocity");
+
+		bb = plan->create_blackboard(nullptr);
+		CHECK(bb->get_var("health") == Variant(100));
+		CHECK(bb->get_var("velocity") == Variant(1.5));
+		CHECK_FALSE(bb->has_var("speed"));
+	}
+	SUBCASE("Mapped variables are linked to the parent scope") {
+		Ref<Blackboard> parent = memnew(Blackboard);
+		parent->set_var("team_speed", 5.0);
+		plan->set("mapping/speed", StringName("team_speed"));
+
+		bb = plan->create_blackboard(nullptr, parent);
+		CHECK(bb->get_var("speed") == Variant(5.0));
+		parent->set_var("team_speed", 6.0);
+		CHECK(bb->get_var("speed") == Variant(6.0));
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] Test BlackboardPlan lazy NodePath prefetch") {
+	Node *root = memnew(Node);
+	Node *target = memnew(Node);
+	target->set_name("Target");
+	root->add_child(target);
+
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	plan->set_lazy_nodepath_prefetch(true);
+	BBVariable path_var(Variant::NODE_PATH);
+	path_var.set_value(NodePath("Target"));
+	plan->add_var("target", path_var);
+	BBVariable missing_var(Variant::NODE_PATH);
+	missing_var.set_value(NodePath("Missing"));
+	plan->add_var("missing", missing_var);
+
+	Ref<Blackboard> bb = plan->create_blackboard(root);
+	Blackboard::VarHandle handle;
+	BBVariable *var = bb->resolve_var("target", handle);
+	REQUIRE(var != nullptr);
+	CHECK(var->is_node_path_pending());
+
+	SUBCASE("NodePath is resolved on first read") {
+		CHECK(bb->get_var("target") == Variant(target));
+		CHECK_FALSE(var->is_node_path_pending());
+
+		// * Freed node reads as null.
+		memdelete(target);
+		CHECK(bb->get_var("target").get_validated_object() == nullptr);
+	}
+	SUBCASE("Unresolved NodePath reads as null") {
+		ERR_PRINT_OFF;
+		CHECK(bb->get_var("missing") == Variant());
+		ERR_PRINT_ON;
+	}
+	SUBCASE("NodePaths can be resolved ahead of the first read") {
+		Ref<Blackboard> child = memnew(Blackboard);
+		child->set_parent(bb);
+		ERR_PRINT_OFF;
+		child->resolve_node_paths();
+		ERR_PRINT_ON;
+		CHECK_FALSE(var->is_node_path_pending());
+		CHECK(bb->get_var("target") == Variant(target));
+	}
+	SUBCASE("Assignment skips resolution") {
+		bb->set_var("target", root);
+		CHECK_FALSE(var->is_node_path_pending());
+		CHECK(bb->get_var("target") == Variant(root));
+	}
+
+	memdelete(root);
+}
+
+TEST_CASE("[Modules][LimboAI] Test BlackboardPlan variable order") {
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	plan->add_var("a", BBVariable(Variant::INT));
+	plan->add_var("b", BBVariable(Variant::INT));
+	plan->add_var("c", BBVariable(Variant::INT));
+	plan->add_var("d", BBVariable(Variant::INT));
+
+	SUBCASE("Test move_var()") {
+		plan->move_var(0, 2);
+		CHECK(plan->get_var_by_index(0).first == StringName("b"));
+		CHECK(plan->get_var_by_index(1).first == StringName("c"));
+		CHECK(plan->get_var_by_index(2).first == StringName("a"));
+		plan->move_var(3, 0);
+		CHECK(plan->get_var_by_index(0).first == StringName("d"));
+		CHECK(plan->get_var_by_index(3).first == StringName("a"));
+	}
+	SUBCASE("Test remove_var() and rename_var()") {
+		plan->remove_var("b");
+		plan->rename_var("c", "e");
+		REQUIRE(plan->get_var_count() == 3);
+		CHECK(plan->get_var_by_index(1).first == StringName("e"));
+		CHECK(plan->get_var_by_index(2).first == StringName("d"));
+		CHECK(plan->has_var("d"));
+		CHECK_FALSE(plan->has_var("c"));
+	}
+	SUBCASE("Derived plan follows the base plan order") {
+		Ref<BlackboardPlan> derived = memnew(BlackboardPlan);
+		derived->set_base_plan(plan);
+		plan->remove_var("a");
+		plan->move_var(2, 0);
+		plan->add_var("e", BBVariable(Variant::INT));
+		derived->sync_with_base_plan();
+		REQUIRE(derived->get_var_count() == 4);
+		CHECK(derived->get_var_by_index(0).first == StringName("d"));
+		CHECK(derived->get_var_by_index(1).first == StringName("b"));
+		CHECK(derived->get_var_by_index(2).first == StringName("c"));
+		CHECK(derived->get_var_by_index(3).first == StringName("e"));
+		CHECK_FALSE(derived->has_var("a"));
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] Test BlackboardPlan shared defaults") {
+	Array waypoints;
+	waypoints.push_back(Vector2(1, 1));
+	Array nested;
+	nested.push_back(1);
+	waypoints.push_back(nested);
+
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	plan->set_prefetch_nodepath_vars(false);
+	BBVariable var(Variant::ARRAY);
+	var.set_value(waypoints);
+	plan->add_var("waypoints", var);
+
+	SUBCASE("Defaults are duplicated by default") {
+		Ref<Blackboard> bb = plan->create_blackboard(nullptr);
+		Array value = bb->get_var("waypoints");
+		CHECK_FALSE(value.is_read_only());
+		value.push_back(Vector2(2, 2));
+		CHECK(waypoints.size() == 2);
+	}
+	SUBCASE("Shared defaults are read-only") {
+		plan->set_share_defaults(true);
+		CHECK(waypoints.is_read_only());
+		CHECK(nested.is_read_only());
+
+		Ref<Blackboard> bb1 = plan->create_blackboard(nullptr);
+		Ref<Blackboard> bb2 = plan->create_blackboard(nullptr);
+		Array value1 = bb1->get_var("waypoints");
+		Array value2 = bb2->get_var("waypoints");
+		CHECK(value1.id() == waypoints.id());
+		CHECK(value2.id() == waypoints.id());
+
+		// * Writing replaces the shared value with a private one.
+		Array own = value1.duplicate();
+		own.push_back(Vector2(2, 2));
+		bb1->set_var("waypoints", own);
+		CHECK(Array(bb1->get_var("waypoints")).size() == 3);
+		CHECK(Array(bb2->get_var("waypoints")).size() == 2);
+		CHECK(waypoints.size() == 2);
+
+		// * Resetting restores the shared value.
+		plan->reset_blackboard(bb1, nullptr);
+		CHECK(Array(bb1->get_var("waypoints")).id() == waypoints.id());
+	}
+	SUBCASE("Disabling sharing makes defaults editable") {
+		plan->set_share_defaults(true);
+		plan->set_share_defaults(false);
+		Array plan_value = plan->get_var("waypoints").get_value();
+		CHECK_FALSE(plan_value.is_read_only());
+		CHECK_FALSE(Array(plan_value[1]).is_read_only());
+
+		Ref<Blackboard> bb = plan->create_blackboard(nullptr);
+		Array value = bb->get_var("waypoints");
+		CHECK_FALSE(value.is_read_only());
+		CHECK(value.id() != plan_value.id());
+	}
+	SUBCASE("Read-only values are duplicated unless sharing is enabled") {
+		waypoints.make_read_only();
+		Ref<Blackboard> bb = plan->create_blackboard(nullptr);
+		Array value = bb->get_var("waypoints");
+		CHECK(value.id() != waypoints.id());
+		CHECK_FALSE(value.is_read_only());
+	}
+}
+
 } //namespace TestBlackboard
 
 #endif // TEST_BLACKBOARD_H
@@ -0,0 +1,585 @@
+/**
+ * test_bt_instance.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_INSTANCE_H
+#define TEST_BT_INSTANCE_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/bb_param/bb_node.h"
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_check_var.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_set_var.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_dynamic_sequence.h"
+#include "modules/limboai/bt/tasks/composites/bt_parallel.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_subtree.h"
+#include "modules/limboai/bt/tasks/scene/bt_set_agent_property.h"
+#include "modules/limboai/bt/tasks/utility/bt_call_method.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait.h"
+
+#include "core/object/worker_thread_pool.h"
+
+namespace TestBTInstance {
+
+TEST_CASE("[Modules][LimboAI] BTInstance") {
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTSelector> sel = memnew(BTSelector);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::FAILURE));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTTestAction> task3 = memnew(BTTestAction(BTTask::SUCCESS));
+
+	root->add_child(sel);
+	sel->add_child(task1);
+	sel->add_child(task2);
+	root->add_child(task3);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	root->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(root, "", dummy);
+	REQUIRE(inst.is_valid());
+
+	SUBCASE("Test task table") {
+		REQUIRE(inst->get_task_count() == 5);
+
+		// * Tasks are stored in depth-first order.
+		CHECK(inst->get_task(0) == root);
+		CHECK(inst->get_task(1) == sel);
+		CHECK(inst->get_task(2) == task1);
+		CHECK(inst->get_task(3) == task2);
+		CHECK(inst->get_task(4) == task3);
+
+		CHECK(inst->get_task_entry(0).parent == -1);
+		CHECK(inst->get_task_entry(1).parent == 0);
+		CHECK(inst->get_task_entry(2).parent == 1);
+		CHECK(inst->get_task_entry(3).parent == 1);
+		CHECK(inst->get_task_entry(4).parent == 0);
+
+		CHECK(inst->get_task_entry(0).depth == 0);
+		CHECK(inst->get_task_entry(3).depth == 2);
+
+		// * Subtree ranges are exclusive.
+		CHECK(inst->get_task_entry(0).subtree_end == 5);
+		CHECK(inst->get_task_entry(1).subtree_end == 4);
+		CHECK(inst->get_task_entry(2).subtree_end == 3);
+		CHECK(inst->get_task_entry(4).subtree_end == 5);
+
+		CHECK(inst->find_task(task2) == 3);
+		Ref<BTTestAction> outsider = memnew(BTTestAction);
+		CHECK(inst->find_task(outsider) == -1);
+	}
+
+	SUBCASE("Test task table after tree changes") {
+		inst->set_compiled(true);
+		CHECK(inst->update(0.01666) == BTTask::RUNNING);
+
+		// * Removed tasks leave the table.
+		sel->remove_child(task2);
+		REQUIRE(inst->get_task_count() == 4);
+		CHECK(inst->find_task(task2) == -1);
+		CHECK(inst->get_task(3) == task3);
+		CHECK(inst->update(0.01666) == BTTask::FAILURE);
+
+		// * Added tasks join the table.
+		Ref<BTTestAction> task4 = memnew(BTTestAction(BTTask::SUCCESS));
+		sel->add_child(task4);
+		REQUIRE(inst->get_task_count() == 5);
+		CHECK(inst->find_task(task4) == 3);
+		CHECK(inst->get_task_entry(3).parent == 1);
+		CHECK(inst->update(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task4, BTTask::SUCCESS, 1, 1, 1);
+	}
+
+	SUBCASE("Test reset()") {
+		CHECK(inst->update(0.01666) == BTTask::RUNNING);
+		CHECK(task2->get_status() == BTTask::RUNNING);
+
+		inst->reset();
+		CHECK(inst->get_last_status() == BTTask::FRESH);
+		CHECK(root->get_status() == BTTask::FRESH);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 1, 1, 1);
+	}
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance reactive updates") {
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTDynamicSequence> dyn = memnew(BTDynamicSequence);
+	Ref<BTTestAction> cond = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> action = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTTestAction> last = memnew(BTTestAction(BTTask::RUNNING));
+
+	root->add_child(dyn);
+	dyn->add_child(cond);
+	dyn->add_child(action);
+	root->add_child(last);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	root->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(root, "", dummy);
+	REQUIRE(inst.is_valid());
+	inst->set_reactive(true);
+
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(cond, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(action, 1, 1, 0);
+
+	SUBCASE("Running task is resumed directly") {
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(action, BTTask::RUNNING, 1, 3, 0);
+		CHECK(root->get_elapsed_time() == doctest::Approx(0.2));
+		CHECK(dyn->get_elapsed_time() == doctest::Approx(0.2));
+	}
+	SUBCASE("Conditions are re-evaluated when blackboard changes") {
+		bb->set_var("foo", 1);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 2, 2, 2);
+		CHECK_ENTRIES_TICKS_EXITS(action, 1, 2, 0);
+
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 2, 2, 2);
+	}
+	SUBCASE("Conditions are re-evaluated when a linked variable changes") {
+		Ref<Blackboard> shared = memnew(Blackboard);
+		shared->set_var("alarm", false);
+		bb->link_var("alarm", shared, "alarm", true);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 2, 2, 2);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 2, 2, 2);
+
+		// * Written through the other blackboard.
+		shared->set_var("alarm", true);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 3, 3, 3);
+		CHECK_ENTRIES_TICKS_EXITS(action, 1, 4, 0);
+	}
+	SUBCASE("Conditions are re-evaluated on request") {
+		inst->request_reevaluation();
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 2, 2, 2);
+		CHECK_ENTRIES_TICKS_EXITS(action, 1, 2, 0);
+	}
+	SUBCASE("Completion is passed up the running path") {
+		action->ret_status = BTTask::SUCCESS;
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(action, BTTask::SUCCESS, 1, 2, 1);
+		CHECK(dyn->get_status() == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(last, BTTask::RUNNING, 1, 1, 0);
+
+		last->ret_status = BTTask::FAILURE;
+		CHECK(inst->update(0.1) == BTTask::FAILURE);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(last, BTTask::FAILURE, 1, 2, 1);
+		CHECK(root->get_status() == BTTask::FAILURE);
+	}
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance reactive updates with writes during a tick") {
+	// Higher priority branch checks a variable that the running branch sets before it starts waiting.
+	Ref<BTDynamicSelector> root = memnew(BTDynamicSelector);
+	Ref<BTSequence> alarm_seq = memnew(BTSequence);
+	Ref<BTCheckVar> check_alert = memnew(BTCheckVar);
+	Ref<BTTestAction> alarm = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTSequence> idle_seq = memnew(BTSequence);
+	Ref<BTSetVar> set_alert = memnew(BTSetVar);
+	Ref<BTTestAction> idle = memnew(BTTestAction(BTTask::RUNNING));
+
+	Ref<BBVariant> true_value = memnew(BBVariant);
+	true_value->set_value_source(BBParam::SAVED_VALUE);
+	true_value->set_saved_value(true);
+	check_alert->set_variable("alert");
+	check_alert->set_check_type(LimboUtility::CHECK_EQUAL);
+	check_alert->set_value(true_value);
+	set_alert->set_variable("alert");
+	set_alert->set_value(true_value);
+
+	root->add_child(alarm_seq);
+	alarm_seq->add_child(check_alert);
+	alarm_seq->add_child(alarm);
+	root->add_child(idle_seq);
+	idle_seq->add_child(set_alert);
+	idle_seq->add_child(idle);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("alert", false);
+	root->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(root, "", dummy);
+	REQUIRE(inst.is_valid());
+	inst->set_reactive(true);
+
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK(check_alert->get_status() == BTTask::FAILURE);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(idle, BTTask::RUNNING, 1, 1, 0);
+	CHECK(bb->get_var("alert", false) == Variant(true));
+
+	// * The write made during the previous tick preempts the running branch.
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(alarm, BTTask::RUNNING, 1, 1, 0);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(idle, BTTask::FRESH, 1, 1, 1);
+
+	// * Without further writes, the new running task is resumed directly.
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK_STATUS_ENTRIES_TICKS_EXITS(alarm, BTTask::RUNNING, 1, 2, 0);
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance compiled backend") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	SUBCASE("Sequence and selector") {
+		Ref<BTSequence> root = memnew(BTSequence);
+		Ref<BTSelector> sel = memnew(BTSelector);
+		Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::FAILURE));
+		Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+		Ref<BTTestAction> task3 = memnew(BTTestAction(BTTask::SUCCESS));
+		root->add_child(sel);
+		sel->add_child(task1);
+		sel->add_child(task2);
+		root->add_child(task3);
+		root->initialize(dummy, bb, dummy);
+		Ref<BTInstance> inst = BTInstance::create(root, "", dummy);
+		inst->set_compiled(true);
+		REQUIRE(inst->is_compiled());
+
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::FAILURE, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::RUNNING, 1, 2, 0);
+		CHECK(sel->get_elapsed_time() == doctest::Approx(0.1));
+
+		task2->ret_status = BTTask::SUCCESS;
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::SUCCESS, 1, 1, 1);
+		CHECK(root->get_status() == BTTask::SUCCESS);
+		CHECK(root->get_elapsed_time() == 0.0);
+	}
+	SUBCASE("Dynamic sequence") {
+		Ref<BTDynamicSequence> root = memnew(BTDynamicSequence);
+		Ref<BTTestAction> cond = memnew(BTTestAction(BTTask::SUCCESS));
+		Ref<BTTestAction> action = memnew(BTTestAction(BTTask::RUNNING));
+		root->add_child(cond);
+		root->add_child(action);
+		root->initialize(dummy, bb, dummy);
+		Ref<BTInstance> inst = BTInstance::create(root, "", dummy);
+		inst->set_compiled(true);
+
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK(inst->update(0.1) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(cond, 2, 2, 2);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(action, BTTask::RUNNING, 1, 2, 0);
+
+		// * Running action is cancelled when a preceding condition fails.
+		cond->ret_status = BTTask::FAILURE;
+		CHECK(inst->update(0.1) == BTTask::FAILURE);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(action, BTTask::FRESH, 1, 2, 1);
+	}
+	SUBCASE("Parallel") {
+		Ref<BTParallel> root = memnew(BTParallel);
+		Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+		Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+		root->add_child(task1);
+		root->add_child(task2);
+		root->initialize(dummy, bb, dummy);
+		Ref<BTInstance> inst = BTInstance::create(root, "", dummy);
+		inst->set_compiled(true);
+
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::RUNNING, 1, 1, 0);
+
+		// * Children are reset when the parallel is entered again.
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(task2, 2, 2, 1);
+	}
+
+	memdelete(dummy);
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][LimboAI] BTInstance task profiling") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTSelector> sel = memnew(BTSelector);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::FAILURE));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task3 = memnew(BTTestAction(BTTask::SUCCESS));
+	root->add_child(sel);
+	sel->add_child(task1);
+	sel->add_child(task2);
+	root->add_child(task3);
+	root->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(root, "", dummy);
+
+	CHECK_FALSE(inst->is_profiling_tasks());
+	CHECK(inst->get_task_profile(0).is_empty());
+
+	SUBCASE("Interpreted") {
+		inst->set_compiled(false);
+	}
+	SUBCASE("Compiled") {
+		inst->set_compiled(true);
+	}
+
+	inst->set_profile_tasks(true);
+	REQUIRE(inst->is_profiling_tasks());
+	inst->update(0.1);
+	inst->update(0.1);
+
+	for (int i = 0; i < inst->get_task_count(); i++) {
+		Dictionary profile = inst->get_task_profile(i);
+		CHECK(int(profile["calls"]) == 2);
+		CHECK(int64_t(profile["inclusive_usec"]) >= int64_t(profile["exclusive_usec"]));
+	}
+
+	// * Exclusive time of a composite leaves out its children.
+	const LimboTaskProfiler::Stats *root_stats = inst->get_task_stats(0);
+	const LimboTaskProfiler::Stats *sel_stats = inst->get_task_stats(inst->find_task(sel));
+	const LimboTaskProfiler::Stats *task3_stats = inst->get_task_stats(inst->find_task(task3));
+	REQUIRE(root_stats != nullptr);
+	CHECK(root_stats->exclusive_usec == root_stats->inclusive_usec - sel_stats->inclusive_usec - task3_stats->inclusive_usec);
+
+	inst->reset_task_profile();
+	CHECK(int(inst->get_task_profile(0)["calls"]) == 0);
+
+	inst->set_profile_tasks(false);
+	inst->update(0.1);
+	CHECK(inst->get_task_profile(0).is_empty());
+	CHECK(inst->get_task_stats(0) == nullptr);
+
+	memdelete(dummy);
+}
+#endif // DEBUG_ENABLED
+
+TEST_CASE("[Modules][LimboAI] BTInstance command buffer") {
+	Node *agent = memnew(Node);
+	agent->set_name("Agent");
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	Ref<BBVariant> name_a = memnew(BBVariant("A"));
+	Ref<BTSetAgentProperty> set_name = memnew(BTSetAgentProperty);
+	set_name->set_property("name");
+	set_name->set_value(name_a);
+
+	Ref<BBNode> agent_param = memnew(BBNode);
+	agent_param->set_saved_value(NodePath("."));
+	TypedArray<BBVariant> args;
+	args.push_back(memnew(BBVariant("B")));
+	Ref<BTCallMethod> call_set_name = memnew(BTCallMethod);
+	call_set_name->set_node_param(agent_param);
+	call_set_name->set_method("set_name");
+	call_set_name->set_args(args);
+
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTTestAction> probe = memnew(BTTestAction);
+
+	SUBCASE("Writes are applied in recording order") {
+		root->add_child(set_name);
+		root->add_child(call_set_name);
+		root->add_child(probe);
+		root->initialize(agent, bb, agent);
+		Ref<BTInstance> inst = BTInstance::create(root, "", agent);
+		inst->set_use_command_buffer(true);
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK(agent->get_name() == StringName("B"));
+	}
+	SUBCASE("Writes are applied in recording order (reversed)") {
+		root->add_child(call_set_name);
+		root->add_child(set_name);
+		root->add_child(probe);
+		root->initialize(agent, bb, agent);
+		Ref<BTInstance> inst = BTInstance::create(root, "", agent);
+		inst->set_use_command_buffer(true);
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK(agent->get_name() == StringName("A"));
+	}
+	SUBCASE("Writes are applied at the end of the update") {
+		// * Calls with a result are made immediately, so they observe the scene before the flush.
+		Ref<BTCallMethod> call_get_name = memnew(BTCallMethod);
+		call_get_name->set_node_param(agent_param);
+		call_get_name->set_method("get_name");
+		call_get_name->set_result_var("seen_name");
+		root->add_child(set_name);
+		root->add_child(call_get_name);
+		root->initialize(agent, bb, agent);
+		Ref<BTInstance> inst = BTInstance::create(root, "", agent);
+
+		inst->set_use_command_buffer(true);
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK(bb->get_var("seen_name") == Variant(StringName("Agent")));
+		CHECK(agent->get_name() == StringName("A"));
+
+		inst->set_use_command_buffer(false);
+		name_a->set_saved_value("C");
+		CHECK(inst->update(0.1) == BTTask::SUCCESS);
+		CHECK(bb->get_var("seen_name") == Variant(StringName("C")));
+	}
+
+	memdelete(agent);
+}
+
+static void _prewarm_pool_task(void *p_bt) {
+	static_cast<BehaviorTree *>(p_bt)->prewarm_pool(4);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance pooling") {
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTWait> wait = memnew(BTWait);
+	wait->set_duration(10.0);
+	seq->add_child(wait);
+	bt->set_root_task(seq);
+
+	Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+	BBVariable speed(Variant::FLOAT);
+	speed.set_value(1.5);
+	plan->add_var("speed", speed);
+	bt->set_blackboard_plan(plan);
+
+	Node *agent1 = memnew(Node);
+	Node *agent2 = memnew(Node);
+
+	Ref<BTInstance> inst = bt->instantiate_pooled(agent1, agent1, agent1);
+	REQUIRE(inst.is_valid());
+	CHECK(inst->get_blackboard()->get_var("speed") == Variant(1.5));
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	inst->get_blackboard()->set_var("speed", 5.0);
+	inst->get_blackboard()->set_var("extra", 1);
+
+	Ref<BTTask> root = inst->get_root_task();
+	Ref<Blackboard> bb = inst->get_blackboard();
+	bt->release_instance(inst);
+	CHECK(bt->get_pooled_instance_count() == 1);
+	CHECK(root->get_status() == BTTask::FRESH);
+
+	SUBCASE("Released instance is recycled") {
+		Ref<BTInstance> recycled = bt->instantiate_pooled(agent2, agent2, agent2);
+		CHECK(recycled == inst);
+		CHECK(bt->get_pooled_instance_count() == 0);
+		CHECK(recycled->get_root_task() == root);
+		CHECK(recycled->get_agent() == agent2);
+		CHECK(recycled->get_blackboard() == bb);
+
+		// * Blackboard is reset to the plan defaults.
+		CHECK(bb->get_var("speed") == Variant(1.5));
+		CHECK_FALSE(bb->has_var("extra"));
+		CHECK(recycled->update(0.1) == BTTask::RUNNING);
+	}
+	SUBCASE("Prewarmed instances are bound on demand") {
+		bt->prewarm_pool(2);
+		CHECK(bt->get_pooled_instance_count() == 3);
+
+		Ref<BTInstance> prewarmed = bt->instantiate_pooled(agent2, agent2, agent2);
+		REQUIRE(prewarmed.is_valid());
+		CHECK(prewarmed != inst);
+		CHECK(prewarmed->get_agent() == agent2);
+		CHECK(prewarmed->get_owner_node() == agent2);
+		CHECK(prewarmed->get_blackboard()->get_var("speed") == Variant(1.5));
+		CHECK(prewarmed->update(0.1) == BTTask::RUNNING);
+	}
+	SUBCASE("Pool can be prewarmed on a worker thread") {
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(&_prewarm_pool_task, bt.ptr());
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+		CHECK(bt->get_pooled_instance_count() == 5);
+
+		Ref<BTInstance> prewarmed = bt->instantiate_pooled(agent2, agent2, agent2);
+		REQUIRE(prewarmed.is_valid());
+		CHECK(prewarmed != inst);
+		CHECK(prewarmed->get_agent() == agent2);
+		CHECK(prewarmed->get_blackboard()->get_var("speed") == Variant(1.5));
+		CHECK(prewarmed->update(0.1) == BTTask::RUNNING);
+		CHECK(bt->get_pooled_instance_count() == 4);
+	}
+	SUBCASE("Pool is cleared when the tree changes") {
+		bt->set_root_task(seq);
+		CHECK(bt->get_pooled_instance_count() == 0);
+	}
+	SUBCASE("Only pooled instances can be released") {
+		Ref<Blackboard> other_bb = memnew(Blackboard);
+		Ref<BTInstance> other = bt->instantiate(agent2, other_bb, agent2, agent2);
+		ERR_PRINT_OFF;
+		bt->release_instance(other);
+		bt->release_instance(inst);
+		ERR_PRINT_ON;
+		CHECK(bt->get_pooled_instance_count() == 1);
+	}
+
+	memdelete(agent1);
+	memdelete(agent2);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance pooling with subtrees") {
+	Ref<BehaviorTree> sub_bt = memnew(BehaviorTree);
+	Ref<BTWait> wait = memnew(BTWait);
+	wait->set_duration(10.0);
+	sub_bt->set_root_task(wait);
+
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTSubtree> subtree = memnew(BTSubtree);
+	subtree->set_subtree(sub_bt);
+	bt->set_root_task(subtree);
+
+	Node *agent1 = memnew(Node);
+	Node *agent2 = memnew(Node);
+
+	// * Tasks of the subtree are added to the task table when the instance is bound.
+	Ref<BTInstance> unbound = bt->instantiate_unbound();
+	REQUIRE(unbound.is_valid());
+	CHECK(unbound->get_task_count() == 1);
+	bt->release_instance(unbound);
+
+	Ref<BTInstance> inst = bt->instantiate_pooled(agent1, agent1, agent1);
+	REQUIRE(inst == unbound);
+	CHECK(inst->get_task_count() == 2);
+	CHECK(inst->get_task_entry(1).parent == 0);
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	Ref<Blackboard> bb = inst->get_blackboard()->get_parent();
+	REQUIRE(bb.is_valid());
+	bt->release_instance(inst);
+
+	Ref<BTInstance> recycled = bt->instantiate_pooled(agent2, agent2, agent2);
+	REQUIRE(recycled == inst);
+	Ref<BTTask> root = recycled->get_root_task();
+	REQUIRE(root->get_child_count() == 1);
+	Ref<BTTask> child = root->get_child(0);
+
+	// * The subtree is bound to the new agent and scope.
+	CHECK(root->get_agent() == agent2);
+	CHECK(child->get_agent() == agent2);
+	CHECK(root->get_blackboard()->get_parent() == bb);
+	CHECK(bb->get_parent().is_null());
+	CHECK(child->get_blackboard() == root->get_blackboard());
+	CHECK(recycled->get_task_count() == 2);
+	CHECK(recycled->update(0.1) == BTTask::RUNNING);
+	CHECK(child->get_status() == BTTask::RUNNING);
+
+	memdelete(agent1);
+	memdelete(agent2);
+}
+
+} //namespace TestBTInstance
+
+#endif // TEST_BT_INSTANCE_H
@@ -0,0 +1,388 @@
+/**
+ * test_bt_scheduler.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_SCHEDULER_H
+#define TEST_BT_SCHEDULER_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/behavior_tree.h"
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/bt_player.h"
+#include "modules/limboai/bt/bt_scheduler.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait.h"
+
+#include "core/object/callable_mp.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#ifndef _3D_DISABLED
+#include "scene/3d/camera_3d.h"
+#endif // ! _3D_DISABLED
+
+namespace TestBTScheduler {
+
+// Fake clock for the tick budget, advanced only by BTSlowTestAction.
+static uint64_t fake_ticks_usec = 0;
+static uint64_t _get_fake_ticks_usec() { return fake_ticks_usec; }
+
+// Takes a while to tick (on the fake clock) and remembers the delta it received.
+class BTSlowTestAction : public BTTestAction {
+public:
+	double last_delta = 0.0;
+
+protected:
+	virtual Status _tick(double p_delta) override {
+		fake_ticks_usec += 200;
+		last_delta = p_delta;
+		return BTTestAction::_tick(p_delta);
+	}
+
+public:
+	BTSlowTestAction() :
+			BTTestAction(BTTask::RUNNING) {}
+};
+
+TEST_CASE("[Modules][LimboAI] BTScheduler") {
+	BTScheduler *scheduler = memnew(BTScheduler);
+	CHECK(BTScheduler::get_singleton() == scheduler);
+
+	Ref<BTTestAction> task = memnew(BTTestAction(BTTask::RUNNING));
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	task->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(task, "", dummy);
+	REQUIRE(inst.is_valid());
+
+	CHECK(scheduler->get_instance_group(inst) == -1);
+	scheduler->add_instance(inst, BTScheduler::GROUP_IDLE);
+	CHECK(scheduler->get_instance_group(inst) == BTScheduler::GROUP_IDLE);
+	CHECK(scheduler->get_instance_count(BTScheduler::GROUP_IDLE) == 1);
+	CHECK(scheduler->get_instance_count(BTScheduler::GROUP_PHYSICS) == 0);
+
+	SUBCASE("Registered instances are updated with their group") {
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(task->num_ticks == 0);
+		scheduler->update_group(BTScheduler::GROUP_IDLE, 0.1);
+		scheduler->update_group(BTScheduler::GROUP_IDLE, 0.1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::RUNNING, 1, 2, 0);
+		CHECK(inst->get_last_status() == BTTask::RUNNING);
+	}
+	SUBCASE("Moving an instance to another group") {
+		scheduler->add_instance(inst, BTScheduler::GROUP_PHYSICS);
+		CHECK(scheduler->get_instance_group(inst) == BTScheduler::GROUP_PHYSICS);
+		CHECK(scheduler->get_instance_count(BTScheduler::GROUP_IDLE) == 0);
+		CHECK(scheduler->get_instance_count(BTScheduler::GROUP_PHYSICS) == 1);
+		scheduler->update_group(BTScheduler::GROUP_IDLE, 0.1);
+		CHECK(task->num_ticks == 0);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(task->num_ticks == 1);
+	}
+	SUBCASE("Thread-safe instances are updated on worker threads") {
+		Ref<BTWait> wait = memnew(BTWait);
+		wait->set_duration(10.0);
+		Ref<BehaviorTree> bt = memnew(BehaviorTree);
+		bt->set_root_task(wait);
+		REQUIRE(bt->is_thread_safe());
+		Ref<Blackboard> pure_bb = memnew(Blackboard);
+		Ref<BTInstance> pure_inst = bt->instantiate(dummy, pure_bb, dummy, dummy);
+		REQUIRE(pure_inst.is_valid());
+
+		Ref<CallbackCounter> counter = memnew(CallbackCounter);
+		pure_inst->connect("updated", callable_mp(counter.ptr(), &CallbackCounter::callback_delta));
+		pure_inst->set_thread_safe(true);
+		CHECK(pure_inst->is_thread_safe());
+		scheduler->add_instance(pure_inst, BTScheduler::GROUP_IDLE);
+		scheduler->set_use_threads(true);
+		scheduler->update_group(BTScheduler::GROUP_IDLE, 0.1);
+		scheduler->update_group(BTScheduler::GROUP_IDLE, 0.1);
+		CHECK(pure_inst->get_last_status() == BTTask::RUNNING);
+		CHECK(pure_inst->get_root_task()->get_elapsed_time() == doctest::Approx(0.1));
+		CHECK(counter->num_callbacks == 2);
+		// * Other instances are still updated on the main thread.
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task, BTTask::RUNNING, 1, 2, 0);
+		scheduler->remove_instance(pure_inst);
+	}
+	SUBCASE("Instances of trees that aren't thread-safe can't be marked thread-safe") {
+		ERR_PRINT_OFF;
+		inst->set_thread_safe(true);
+		ERR_PRINT_ON;
+		CHECK_FALSE(inst->is_thread_safe());
+	}
+	SUBCASE("Removed instances are not updated") {
+		scheduler->remove_instance(inst);
+		CHECK(scheduler->get_instance_group(inst) == -1);
+		CHECK(scheduler->get_instance_count(BTScheduler::GROUP_IDLE) == 0);
+		scheduler->update_group(BTScheduler::GROUP_IDLE, 0.1);
+		CHECK(task->num_ticks == 0);
+	}
+
+	memdelete(scheduler);
+	CHECK(BTScheduler::get_singleton() == nullptr);
+	CHECK(inst->get_reference_count() == 1);
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTScheduler tick budget") {
+	BTScheduler *scheduler = memnew(BTScheduler);
+	scheduler->set_ticks_usec_func(&_get_fake_ticks_usec);
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	Ref<BTSlowTestAction> tasks[3];
+	Ref<BTInstance> instances[3];
+	for (int i = 0; i < 3; i++) {
+		tasks[i] = Ref<BTSlowTestAction>(memnew(BTSlowTestAction));
+		tasks[i]->initialize(dummy, bb, dummy);
+		instances[i] = BTInstance::create(tasks[i], "", dummy);
+		scheduler->add_instance(instances[i], BTScheduler::GROUP_PHYSICS);
+	}
+
+	SUBCASE("Without budget, all instances are updated") {
+		CHECK(scheduler->get_tick_budget_usec() == 0);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		for (int i = 0; i < 3; i++) {
+			CHECK(tasks[i]->num_ticks == 2);
+			CHECK(tasks[i]->last_delta == doctest::Approx(0.1));
+		}
+	}
+	SUBCASE("Instances are updated in turns and catch up on skipped time") {
+		// Each tick exceeds the budget, so only one instance is updated at a time.
+		scheduler->set_tick_budget_usec(100);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(tasks[0]->num_ticks == 1);
+		CHECK(tasks[1]->num_ticks == 0);
+		CHECK(tasks[2]->num_ticks == 0);
+		CHECK(tasks[0]->last_delta == doctest::Approx(0.1));
+
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(tasks[1]->num_ticks == 1);
+		CHECK(tasks[1]->last_delta == doctest::Approx(0.2));
+
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(tasks[2]->num_ticks == 1);
+		CHECK(tasks[2]->last_delta == doctest::Approx(0.3));
+
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(tasks[0]->num_ticks == 2);
+		CHECK(tasks[0]->last_delta == doctest::Approx(0.3));
+	}
+
+	SUBCASE("Instances within the budget are updated in the same frame") {
+		scheduler->set_tick_budget_usec(500);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		// * The budget is checked before each update: 0, 200 and 400 usec have passed.
+		CHECK(tasks[0]->num_ticks == 1);
+		CHECK(tasks[1]->num_ticks == 1);
+		CHECK(tasks[2]->num_ticks == 1);
+		scheduler->set_tick_budget_usec(300);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(tasks[0]->num_ticks == 2);
+		CHECK(tasks[1]->num_ticks == 2);
+		CHECK(tasks[2]->num_ticks == 1);
+	}
+	SUBCASE("Instances with a tick interval accumulate delta") {
+		scheduler->set_instance_tick_interval(instances[1], 0.3);
+		CHECK(scheduler->get_instance_tick_interval(instances[1]) == doctest::Approx(0.3));
+		for (int i = 0; i < 6; i++) {
+			scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		}
+		CHECK(tasks[0]->num_ticks == 6);
+		CHECK(tasks[1]->num_ticks == 2);
+		CHECK(tasks[1]->last_delta == doctest::Approx(0.3));
+		CHECK(tasks[1]->get_elapsed_time() == doctest::Approx(0.3));
+	}
+
+	memdelete(scheduler);
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTScheduler LOD settings") {
+	BTScheduler *scheduler = memnew(BTScheduler);
+	PackedFloat32Array distances;
+	distances.push_back(10.0);
+	distances.push_back(40.0);
+	PackedFloat32Array intervals;
+	intervals.push_back(0.2);
+	intervals.push_back(0.5);
+
+	SUBCASE("Levels are set when valid") {
+		scheduler->set_lod_levels(distances, intervals);
+		CHECK(scheduler->get_lod_distances() == distances);
+		CHECK(scheduler->get_lod_intervals() == intervals);
+	}
+	SUBCASE("Distances must be ascending") {
+		PackedFloat32Array descending;
+		descending.push_back(40.0);
+		descending.push_back(10.0);
+		ERR_PRINT_OFF;
+		scheduler->set_lod_distances(descending);
+		scheduler->set_lod_levels(descending, intervals);
+		ERR_PRINT_ON;
+		CHECK(scheduler->get_lod_distances().is_empty());
+		CHECK(scheduler->get_lod_intervals().is_empty());
+	}
+	SUBCASE("Intervals can't be negative") {
+		PackedFloat32Array negative;
+		negative.push_back(-1.0);
+		negative.push_back(0.5);
+		ERR_PRINT_OFF;
+		scheduler->set_lod_intervals(negative);
+		ERR_PRINT_ON;
+		CHECK(scheduler->get_lod_intervals().is_empty());
+	}
+	SUBCASE("Arrays must have the same size") {
+		scheduler->set_lod_levels(distances, intervals);
+		PackedFloat32Array single;
+		single.push_back(0.1);
+		ERR_PRINT_OFF;
+		scheduler->set_lod_intervals(single);
+		scheduler->set_lod_distances(single);
+		scheduler->set_lod_levels(distances, single);
+		ERR_PRINT_ON;
+		CHECK(scheduler->get_lod_distances() == distances);
+		CHECK(scheduler->get_lod_intervals() == intervals);
+	}
+
+	memdelete(scheduler);
+}
+
+#ifndef _3D_DISABLED
+TEST_CASE("[SceneTree][LimboAI] BTScheduler distance LOD") {
+	Window *root = SceneTree::get_singleton()->get_root();
+	Camera3D *camera = memnew(Camera3D);
+	root->add_child(camera);
+	camera->make_current();
+	Node3D *agent = memnew(Node3D);
+	root->add_child(agent);
+	agent->set_global_position(Vector3(0.0, 0.0, 50.0));
+
+	BTScheduler *scheduler = memnew(BTScheduler);
+	PackedFloat32Array distances;
+	distances.push_back(10.0);
+	distances.push_back(40.0);
+	PackedFloat32Array intervals;
+	intervals.push_back(0.2);
+	intervals.push_back(0.5);
+	scheduler->set_lod_levels(distances, intervals);
+
+	Ref<BTSlowTestAction> task = memnew(BTSlowTestAction);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	task->initialize(agent, bb, agent);
+	Ref<BTInstance> inst = BTInstance::create(task, "", agent);
+	REQUIRE(inst.is_valid());
+	scheduler->add_instance(inst, BTScheduler::GROUP_PHYSICS);
+
+	SUBCASE("Interval is selected by the farthest exceeded distance") {
+		CHECK(scheduler->get_instance_tick_interval(inst) == doctest::Approx(0.5));
+		agent->set_global_position(Vector3(0.0, 0.0, 20.0));
+		for (int i = 0; i < 5; i++) {
+			scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		}
+		// * Re-evaluated after the update.
+		CHECK(scheduler->get_instance_tick_interval(inst) == doctest::Approx(0.2));
+		agent->set_global_position(Vector3(0.0, 0.0, 5.0));
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(scheduler->get_instance_tick_interval(inst) == doctest::Approx(0.0));
+	}
+	SUBCASE("Skipped frames accumulate delta") {
+		for (int i = 0; i < 4; i++) {
+			scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		}
+		CHECK(task->num_ticks == 0);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(task->num_ticks == 1);
+		CHECK(task->last_delta == doctest::Approx(0.5));
+	}
+	SUBCASE("The larger of instance and LOD intervals is used") {
+		scheduler->set_instance_tick_interval(inst, 1.0);
+		CHECK(scheduler->get_instance_tick_interval(inst) == doctest::Approx(1.0));
+		scheduler->set_instance_tick_interval(inst, 0.1);
+		CHECK(scheduler->get_instance_tick_interval(inst) == doctest::Approx(0.5));
+	}
+
+	memdelete(scheduler);
+	memdelete(agent);
+	memdelete(camera);
+}
+#endif // ! _3D_DISABLED
+
+TEST_CASE("[SceneTree][LimboAI] BTPlayer with scheduler") {
+	ClassDB::register_class<BTTestAction>();
+	BTScheduler::set_enabled(true);
+
+	Node *scene_root = memnew(Node);
+	Ref<BehaviorTree> bt = memnew(BehaviorTree);
+	Ref<BTTestAction> root_task = memnew(BTTestAction);
+	bt->set_root_task(root_task);
+
+	BTPlayer *bt_player = memnew(BTPlayer);
+	bt_player->set_behavior_tree(bt);
+	scene_root->add_child(bt_player);
+	bt_player->set_owner(scene_root);
+	SceneTree::get_singleton()->get_root()->add_child(scene_root);
+
+	REQUIRE(bt_player->get_bt_instance().is_valid());
+	Ref<BTTestAction> task = bt_player->get_bt_instance()->get_root_task();
+	REQUIRE(task.is_valid());
+
+	BTScheduler *scheduler = BTScheduler::get_singleton();
+	REQUIRE(scheduler != nullptr);
+	CHECK_FALSE(bt_player->is_physics_processing());
+	CHECK(scheduler->get_instance_group(bt_player->get_bt_instance()) == BTScheduler::GROUP_PHYSICS);
+
+	Ref<CallbackCounter> counter = memnew(CallbackCounter);
+	bt_player->connect("updated", callable_mp(counter.ptr(), &CallbackCounter::callback_delta));
+
+	SUBCASE("Player's tree is updated by the scheduler") {
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(task->num_ticks == 1);
+		CHECK(counter->num_callbacks == 1);
+	}
+	SUBCASE("Tick interval is passed to the scheduler") {
+		bt_player->set_tick_interval(0.5);
+		CHECK(scheduler->get_instance_tick_interval(bt_player->get_bt_instance()) == doctest::Approx(0.5));
+		for (int i = 0; i < 4; i++) {
+			scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		}
+		CHECK(task->num_ticks == 0);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(task->num_ticks == 1);
+		CHECK(counter->num_callbacks == 1);
+	}
+	SUBCASE("Update mode selects the group") {
+		bt_player->set_update_mode(BTPlayer::IDLE);
+		CHECK(scheduler->get_instance_group(bt_player->get_bt_instance()) == BTScheduler::GROUP_IDLE);
+		bt_player->set_update_mode(BTPlayer::MANUAL);
+		CHECK(scheduler->get_instance_group(bt_player->get_bt_instance()) == -1);
+	}
+	SUBCASE("Inactive players are unregistered") {
+		bt_player->set_active(false);
+		CHECK(scheduler->get_instance_count(BTScheduler::GROUP_PHYSICS) == 0);
+		scheduler->update_group(BTScheduler::GROUP_PHYSICS, 0.1);
+		CHECK(task->num_ticks == 0);
+	}
+	SUBCASE("Players leaving the tree are unregistered") {
+		scene_root->remove_child(bt_player);
+		CHECK(scheduler->get_instance_count(BTScheduler::GROUP_PHYSICS) == 0);
+		memdelete(bt_player);
+	}
+
+	memdelete(scene_root);
+	BTScheduler::finalize();
+	CHECK(BTScheduler::get_singleton() == nullptr);
+	BTScheduler::set_enabled(false);
+}
+
+} //namespace TestBTScheduler
+
+#endif // TEST_BT_SCHEDULER_H
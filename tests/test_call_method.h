@@ -18,6 +18,7 @@
 #include "modules/limboai/blackboard/blackboard.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/utility/bt_call_method.h"
+#include "modules/limboai/util/limbo_command_buffer.h"
 
 #include "core/os/memory.h"
 #include "core/variant/array.h"
@@ -110,6 +111,45 @@ TEST_CASE("[Modules][LimboAI] BTCallMethod") {
 				CHECK(callback_counter->num_callbacks == 1);
 			}
 		}
+		SUBCASE("With command buffer") {
+			LimboCommandBuffer buffer;
+			LimboCommandBuffer::Scope scope(&buffer);
+
+			SUBCASE("Call is deferred until flush") {
+				CHECK(cm->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(callback_counter->num_callbacks == 0);
+				CHECK(buffer.get_command_count() == 1);
+				buffer.flush();
+				CHECK(callback_counter->num_callbacks == 1);
+			}
+			SUBCASE("When method doesn't exist") {
+				cm->set_method("not_found");
+				ERR_PRINT_OFF;
+				CHECK(cm->execute(0.01666) == BTTask::FAILURE);
+				ERR_PRINT_ON;
+				CHECK(buffer.is_empty());
+			}
+			SUBCASE("Should fail with too many arguments") {
+				cm->set_include_delta(true);
+				ERR_PRINT_OFF;
+				CHECK(cm->execute(0.01666) == BTTask::FAILURE);
+				ERR_PRINT_ON;
+				CHECK(buffer.is_empty());
+			}
+			SUBCASE("Should fail with 0 arguments") {
+				cm->set_method("callback_delta");
+				ERR_PRINT_OFF;
+				CHECK(cm->execute(0.01666) == BTTask::FAILURE);
+				ERR_PRINT_ON;
+				CHECK(buffer.is_empty());
+			}
+			SUBCASE("With result variable, the call is immediate") {
+				cm->set_result_var("result");
+				CHECK(cm->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(callback_counter->num_callbacks == 1);
+				CHECK(buffer.is_empty());
+			}
+		}
 
 		memdelete(dummy);
 	}
@@ -19,6 +19,7 @@
 #include "modules/limboai/blackboard/blackboard.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/scene/bt_set_agent_property.h"
+#include "modules/limboai/util/limbo_command_buffer.h"
 
 #include "core/os/memory.h"
 
@@ -58,6 +59,56 @@ TEST_CASE("[Modules][LimboAI] BTSetAgentProperty") {
 		CHECK(sap->execute(0.01666) == BTTask::FAILURE);
 		ERR_PRINT_ON;
 	}
+	SUBCASE("With command buffer") {
+		LimboCommandBuffer buffer;
+		{
+			LimboCommandBuffer::Scope scope(&buffer);
+			CHECK(sap->execute(0.01666) == BTTask::SUCCESS);
+			CHECK(agent->get_process_priority() == 0);
+
+			// * Repeated writes collapse into one, and operations see the pending value.
+			sap->set_operation(LimboUtility::OPERATION_ADDITION);
+			CHECK(sap->execute(0.01666) == BTTask::SUCCESS);
+			CHECK(agent->get_process_priority() == 0);
+		}
+		CHECK(buffer.get_command_count() == 1);
+		buffer.flush();
+		CHECK(buffer.is_empty());
+		CHECK(agent->get_process_priority() == 14);
+
+		// * Missing property fails as it does without a buffer.
+		sap->set_property("not_found");
+		sap->set_operation(LimboUtility::OPERATION_NONE);
+		{
+			LimboCommandBuffer::Scope scope(&buffer);
+			ERR_PRINT_OFF;
+			CHECK(sap->execute(0.01666) == BTTask::FAILURE);
+			ERR_PRINT_ON;
+		}
+		CHECK(buffer.is_empty());
+	}
+	SUBCASE("With command buffer and bound variable") {
+		bb->bind_var_to_property("priority", agent, "process_priority", true);
+		LimboCommandBuffer buffer;
+		{
+			LimboCommandBuffer::Scope scope(&buffer);
+			CHECK(sap->execute(0.01666) == BTTask::SUCCESS);
+			// * The bound variable reads the pending write.
+			CHECK(bb->get_var("priority") == Variant(7));
+			CHECK(agent->get_process_priority() == 0);
+
+			// * Value taken from the bound variable sees the pending write too.
+			value->set_value_source(BBParam::BLACKBOARD_VAR);
+			value->set_variable("priority");
+			sap->set_operation(LimboUtility::OPERATION_ADDITION);
+			CHECK(sap->execute(0.01666) == BTTask::SUCCESS);
+			CHECK(bb->get_var("priority") == Variant(14));
+		}
+		CHECK(buffer.get_command_count() == 1);
+		buffer.flush();
+		CHECK(agent->get_process_priority() == 14);
+		CHECK(bb->get_var("priority") == Variant(14));
+	}
 	SUBCASE("With StringName and String") {
 		value->set_saved_value("TestName");
 		sap->set_property("name");
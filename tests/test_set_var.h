@@ -138,6 +138,20 @@ TEST_CASE("[Modules][LimboAI] BTSetVar") {
 				CHECK(bb->get_var("var", 0) == Variant(5));
 			}
 		}
+		SUBCASE("Performing an operation on floats") {
+			bb->set_var("var", 8.0);
+			value->set_value_source(BBParam::SAVED_VALUE);
+			value->set_saved_value(2.0);
+
+			sv->set_operation(LimboUtility::OPERATION_DIVISION);
+			CHECK(sv->execute(0.01666) == BTTask::SUCCESS);
+			CHECK(bb->get_var("var", 0) == Variant(4.0));
+			CHECK(bb->get_float("var") == doctest::Approx(4.0));
+
+			sv->set_operation(LimboUtility::OPERATION_SUBTRACTION);
+			CHECK(sv->execute(0.01666) == BTTask::SUCCESS);
+			CHECK(bb->get_var("var", 0) == Variant(2.0));
+		}
 		SUBCASE("Performing an operation when assigned variable doesn't exist.") {
 			value->set_value_source(BBParam::SAVED_VALUE);
 			value->set_saved_value(3);
@@ -16,6 +16,7 @@
 
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/scene/bt_stop_animation.h"
+#include "modules/limboai/util/limbo_command_buffer.h"
 
 #include "scene/animation/animation_player.h"
 #include "scene/main/window.h"
@@ -66,6 +67,32 @@ TEST_CASE("[SceneTree][LimboAI] BTStopAnimation") {
 			CHECK(sa->execute(0.01666) == BTTask::SUCCESS);
 			CHECK_FALSE(player->is_playing());
 		}
+		SUBCASE("With command buffer") {
+			LimboCommandBuffer buffer;
+			{
+				LimboCommandBuffer::Scope scope(&buffer);
+				// * Playback recorded earlier in the same update is stopped too.
+				Array play_args;
+				play_args.push_back("test");
+				buffer.call_method(player, "play", play_args);
+				REQUIRE_FALSE(player->is_playing());
+				CHECK(sa->execute(0.01666) == BTTask::SUCCESS);
+				CHECK(buffer.get_command_count() == 2);
+			}
+			buffer.flush();
+			CHECK_FALSE(player->is_playing());
+		}
+		SUBCASE("With command buffer and another animation pending") {
+			sa->set_animation_name("test");
+			LimboCommandBuffer buffer;
+			LimboCommandBuffer::Scope scope(&buffer);
+			Array play_args;
+			play_args.push_back("other");
+			buffer.call_method(player, "play", play_args);
+			CHECK(sa->execute(0.01666) == BTTask::SUCCESS);
+			CHECK(buffer.get_command_count() == 1);
+			buffer.clear();
+		}
 	}
 
 	memdelete(dummy);
@@ -15,10 +15,18 @@
 #include "limbo_test.h"
 
 #include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/behavior_tree.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
 #include "modules/limboai/bt/tasks/utility/bt_call_method.h"
+#include "modules/limboai/bt/tasks/utility/bt_console_print.h"
+#include "modules/limboai/bt/tasks/utility/bt_wait.h"
 #include "tests/test_macros.h"
 
+#ifdef MODULE_GDSCRIPT_ENABLED
+#include "modules/gdscript/gdscript.h"
+#endif
+
 namespace TestTask {
 
 TEST_CASE("[Modules][LimboAI] BTTask") {
@@ -159,6 +167,18 @@ TEST_CASE("[Modules][LimboAI] BTTask") {
 			CHECK(child2->get_parent() == task);
 			CHECK(child2->get_parent() == task);
 		}
+		SUBCASE("Test raw accessors") {
+			int refcount = child2->get_reference_count();
+			CHECK(task->get_child_ptr(1) == child2.ptr());
+			CHECK(child2->get_parent_ptr() == task.ptr());
+			CHECK(child2->get_root_ptr() == task.ptr());
+			CHECK(task->get_parent_ptr() == nullptr);
+			CHECK(child2->get_reference_count() == refcount);
+
+			ERR_PRINT_OFF;
+			CHECK(task->get_child_ptr(3) == nullptr);
+			ERR_PRINT_ON;
+		}
 		SUBCASE("Test initialize()") {
 			Node *dummy = memnew(Node);
 			Ref<Blackboard> bb = memnew(Blackboard);
@@ -216,6 +236,24 @@ TEST_CASE("[Modules][LimboAI] BTTask") {
 		}
 	}
 
+	SUBCASE("Test abort() resets tasks executed out of order") {
+		Ref<BTSequence> seq = memnew(BTSequence);
+		Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+		Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+		seq->add_child(task1);
+		seq->add_child(task2);
+
+		// * Executing a child directly must still make abort() on the parent reach it.
+		task2->execute(0.1);
+		seq->abort();
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 1, 1, 1);
+
+		// * Repeated abort() doesn't call _exit() again.
+		seq->abort();
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::FRESH, 0, 0, 0);
+	}
+
 	SUBCASE("Test clone()") {
 		// * Note: BTTask cannot be duplicated, thus using BTTestAction.
 		Ref<BTTestAction> task = memnew(BTTestAction);
@@ -282,6 +320,54 @@ TEST_CASE("[Modules][LimboAI] BTTask") {
 		CHECK(int(arg1->get_saved_value()) == 42);
 	}
 
+	SUBCASE("Test clone_shared() shares sub-resources of native tasks") {
+		Ref<BTCallMethod> task = memnew(BTCallMethod);
+		Ref<BBNode> node_param = memnew(BBNode);
+		node_param->set_saved_value("some/path");
+		task->set_node_param(node_param);
+
+		Ref<BTTestAction> child = memnew(BTTestAction);
+		task->add_child(child);
+
+		Ref<BTCallMethod> cloned = task->clone_shared();
+		REQUIRE(cloned.is_valid());
+		CHECK_FALSE(cloned == task);
+		CHECK(cloned->get_node_param() == node_param);
+		REQUIRE(cloned->get_child_count() == 1);
+		CHECK_FALSE(cloned->get_child(0) == child);
+	}
+
+	SUBCASE("Test variable dependencies") {
+		Ref<BTTask> task = memnew(BTTask);
+		Node *dummy = memnew(Node);
+		Ref<Blackboard> bb = memnew(Blackboard);
+		bb->set_var("a", 1);
+		bb->set_var("b", 2);
+		task->initialize(dummy, bb, dummy);
+
+		task->add_var_dependency("a");
+		CHECK(task->check_var_dependencies());
+		CHECK_FALSE(task->check_var_dependencies());
+
+		bb->set_var("b", 3);
+		CHECK_FALSE(task->check_var_dependencies());
+
+		bb->set_var("a", 1);
+		CHECK(task->check_var_dependencies());
+		CHECK_FALSE(task->check_var_dependencies());
+
+		// * Re-created variable is detected.
+		bb->erase_var("a");
+		bb->assign_var("a", BBVariable(Variant::INT));
+		CHECK(task->check_var_dependencies());
+
+		task->clear_var_dependencies();
+		bb->set_var("a", 5);
+		CHECK_FALSE(task->check_var_dependencies());
+
+		memdelete(dummy);
+	}
+
 	SUBCASE("Test clone() filters disabled children") {
 		Ref<BTTestAction> task = memnew(BTTestAction);
 		Ref<BTTestAction> child1 = memnew(BTTestAction);
@@ -298,7 +384,126 @@ TEST_CASE("[Modules][LimboAI] BTTask") {
 		REQUIRE(cloned.is_valid());
 		CHECK(cloned->get_child_count() == 2);
 	}
+
+	SUBCASE("Test capabilities") {
+		Ref<BTSequence> seq = memnew(BTSequence);
+		Ref<BTWait> wait = memnew(BTWait);
+		Ref<BTCallMethod> call = memnew(BTCallMethod);
+		seq->add_child(wait);
+
+		Ref<BehaviorTree> bt = memnew(BehaviorTree);
+		bt->set_root_task(seq);
+		CHECK((uint32_t)seq->get_branch_capabilities() == BTTask::CAPABILITY_PURE);
+		CHECK(bt->is_thread_safe());
+
+		seq->add_child(call);
+		CHECK(call->get_capabilities().has_flag(BTTask::CAPABILITY_WRITES_SCENE));
+		CHECK(seq->get_branch_capabilities().has_flag(BTTask::CAPABILITY_CALLS_SCRIPTS));
+		CHECK_FALSE(bt->is_thread_safe());
+
+		// * Disabled tasks are ignored.
+		call->set_enabled(false);
+		CHECK(bt->is_thread_safe());
+
+		// * Printing must happen on the main thread.
+		Ref<BTConsolePrint> print = memnew(BTConsolePrint);
+		seq->add_child(print);
+		CHECK(print->get_capabilities().has_flag(BTTask::CAPABILITY_MAIN_THREAD));
+		CHECK_FALSE(bt->is_thread_safe());
+		seq->remove_child(print);
+		CHECK(bt->is_thread_safe());
+
+		// * Bound properties and lazy node paths in the plan access the scene.
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		plan->add_var("speed", BBVariable(Variant::FLOAT));
+		bt->set_blackboard_plan(plan);
+		CHECK(bt->is_thread_safe());
+		plan->set_property_binding("speed", NodePath(".:speed"));
+		CHECK_FALSE(bt->is_thread_safe());
+		plan->set_property_binding("speed", NodePath());
+		plan->set_lazy_nodepath_prefetch(true);
+		CHECK_FALSE(bt->is_thread_safe());
+		plan->set_lazy_nodepath_prefetch(false);
+		CHECK(bt->is_thread_safe());
+
+		// * Undeclared native tasks are assumed to access the scene.
+		Ref<BTTestAction> undeclared = memnew(BTTestAction);
+		CHECK(undeclared->get_capabilities().has_flag(BTTask::CAPABILITY_READS_SCENE));
+		CHECK(undeclared->get_capabilities().has_flag(BTTask::CAPABILITY_WRITES_SCENE));
+	}
+}
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+TEST_CASE("[Modules][LimboAI] BTTask script overrides") {
+	ClassDB::register_class<BTTestAction>();
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	Ref<GDScript> tick_script = memnew(GDScript);
+	tick_script->set_source_code(
+			"extends BTTestAction\n"
+			"var script_calls := []\n"
+			"func _tick(_delta: float) -> Status:\n"
+			"\tscript_calls.push_back(&\"_tick\")\n"
+			"\treturn SUCCESS\n");
+	REQUIRE(tick_script->reload() == OK);
+
+	SUBCASE("Script that overrides only _tick()") {
+		Ref<BTTestAction> task = memnew(BTTestAction);
+		task->set_script(tick_script);
+		task->initialize(dummy, bb, dummy);
+		CHECK(task->execute(0.1) == BTTask::SUCCESS);
+		Array calls = task->get("script_calls");
+		REQUIRE(calls.size() == 1);
+		CHECK(calls[0] == Variant(StringName("_tick")));
+		// * Native _enter() and _exit() still run; native _tick() is replaced by the script.
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 0, 1);
+	}
+	SUBCASE("Script that overrides only _enter()") {
+		Ref<GDScript> enter_script = memnew(GDScript);
+		enter_script->set_source_code(
+				"extends BTTestAction\n"
+				"var script_calls := []\n"
+				"func _enter() -> void:\n"
+				"\tscript_calls.push_back(&\"_enter\")\n");
+		REQUIRE(enter_script->reload() == OK);
+		Ref<BTTestAction> task = memnew(BTTestAction);
+		task->set_script(enter_script);
+		task->initialize(dummy, bb, dummy);
+		CHECK(task->execute(0.1) == BTTask::SUCCESS);
+		Array calls = task->get("script_calls");
+		REQUIRE(calls.size() == 1);
+		CHECK(calls[0] == Variant(StringName("_enter")));
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 1, 1);
+	}
+	SUBCASE("Native task without a script") {
+		Ref<BTTestAction> task = memnew(BTTestAction);
+		task->initialize(dummy, bb, dummy);
+		CHECK(task->execute(0.1) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 1, 1);
+	}
+	SUBCASE("Uninitialized task calls script virtuals") {
+		Ref<BTTestAction> task = memnew(BTTestAction);
+		task->set_script(tick_script);
+		CHECK(task->execute(0.1) == BTTask::SUCCESS);
+		Array calls = task->get("script_calls");
+		CHECK(calls.size() == 1);
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 0, 1);
+	}
+	SUBCASE("Script attached after initialize() is resolved on the next initialize()") {
+		Ref<BTTestAction> task = memnew(BTTestAction);
+		task->initialize(dummy, bb, dummy);
+		task->set_script(tick_script);
+		CHECK(task->execute(0.1) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(task, 1, 1, 1);
+		task->initialize(dummy, bb, dummy);
+		CHECK(task->execute(0.1) == BTTask::SUCCESS);
+		CHECK_ENTRIES_TICKS_EXITS(task, 2, 1, 2);
+	}
+
+	memdelete(dummy);
 }
+#endif // MODULE_GDSCRIPT_ENABLED
 
 } //namespace TestTask
 
@@ -0,0 +1,70 @@
+/**
+ * test_task_access_benchmark.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_TASK_ACCESS_BENCHMARK_H
+#define TEST_TASK_ACCESS_BENCHMARK_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+
+#include "core/os/os.h"
+
+namespace TestTaskAccessBenchmark {
+
+// Skipped by default, as timings are meaningless in regular test runs.
+// Run with: --test --no-skip --test-case="*Benchmark child access*"
+TEST_CASE("[Modules][LimboAI] Benchmark child access" * doctest::skip()) {
+	const int num_children = 256;
+	const int num_rounds = 20000;
+
+	Ref<BTSelector> root = memnew(BTSelector);
+	for (int i = 0; i < num_children; i++) {
+		Ref<BTTestAction> child = memnew(BTTestAction(BTTask::FAILURE));
+		root->add_child(child);
+	}
+
+	// * Child lookups alone: Ref copy vs raw pointer.
+	int64_t checksum = 0;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < num_rounds; r++) {
+		for (int i = 0; i < num_children; i++) {
+			checksum += root->get_child(i)->get_index();
+		}
+	}
+	uint64_t ref_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < num_rounds; r++) {
+		for (int i = 0; i < num_children; i++) {
+			checksum -= root->get_child_ptr(i)->get_index();
+		}
+	}
+	uint64_t ptr_usec = OS::get_singleton()->get_ticks_usec() - start;
+	CHECK(checksum == 0);
+
+	// * Ticks of a wide selector, which visits every child.
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < num_rounds; r++) {
+		root->execute(0.01);
+	}
+	uint64_t tick_usec = OS::get_singleton()->get_ticks_usec() - start;
+	CHECK(root->get_status() == BTTask::FAILURE);
+
+	String report = vformat("get_child(): %d usec, get_child_ptr(): %d usec, %d ticks of a %d-child selector: %d usec",
+			ref_usec, ptr_usec, num_rounds, num_children, tick_usec);
+	MESSAGE(report.utf8().get_data());
+}
+
+} //namespace TestTaskAccessBenchmark
+
+#endif // TEST_TASK_ACCESS_BENCHMARK_H
@@ -0,0 +1,119 @@
+/**
+ * limbo_command_buffer.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_command_buffer.h"
+
+#include "../compat/object.h"
+
+thread_local LimboCommandBuffer *LimboCommandBuffer::active = nullptr;
+
+void LimboCommandBuffer::set_property(Object *p_object, const StringName &p_property, const Variant &p_value) {
+	ERR_FAIL_NULL(p_object);
+	const uint64_t id = p_object->get_instance_id();
+
+	// Repeated writes of the same property collapse into the first one. A method call
+	// on the object may depend on the earlier value, so the search stops there.
+	for (int i = int(commands.size()) - 1; i >= 0; i--) {
+		Command &cmd = commands[i];
+		if (cmd.object_id != id) {
+			continue;
+		}
+		if (cmd.is_call) {
+			break;
+		}
+		if (cmd.name == p_property) {
+			cmd.value = p_value;
+			return;
+		}
+	}
+
+	Command cmd;
+	cmd.object_id = id;
+	cmd.name = p_property;
+	cmd.value = p_value;
+	commands.push_back(cmd);
+}
+
+bool LimboCommandBuffer::get_property(const Object *p_object, const StringName &p_property, Variant &r_value) const {
+	ERR_FAIL_NULL_V(p_object, false);
+	const uint64_t id = p_object->get_instance_id();
+	for (int i = int(commands.size()) - 1; i >= 0; i--) {
+		const Command &cmd = commands[i];
+		if (cmd.object_id == id && !cmd.is_call && cmd.name == p_property) {
+			r_value = cmd.value;
+			return true;
+		}
+	}
+	return false;
+}
+
+void LimboCommandBuffer::call_method(Object *p_object, const StringName &p_method, const Array &p_args) {
+	ERR_FAIL_NULL(p_object);
+	Command cmd;
+	cmd.object_id = p_object->get_instance_id();
+	cmd.name = p_method;
+	cmd.args = p_args;
+	cmd.is_call = true;
+	commands.push_back(cmd);
+}
+
+// Returns the arguments of the most recent pending call of the method, if there is one.
+bool LimboCommandBuffer::get_last_call(const Object *p_object, const StringName &p_method, Array &r_args) const {
+	ERR_FAIL_NULL_V(p_object, false);
+	const uint64_t id = p_object->get_instance_id();
+	for (int i = int(commands.size()) - 1; i >= 0; i--) {
+		const Command &cmd = commands[i];
+		if (cmd.object_id == id && cmd.is_call && cmd.name == p_method) {
+			r_args = cmd.args;
+			return true;
+		}
+	}
+	return false;
+}
+
+void LimboCommandBuffer::flush() {
+	for (uint32_t i = 0; i < commands.size(); i++) {
+		const Command &cmd = commands[i];
+		// Objects freed since the command was recorded are skipped.
+		Object *obj = OBJECT_DB_GET_INSTANCE(cmd.object_id);
+		if (unlikely(obj == nullptr)) {
+			continue;
+		}
+		if (cmd.is_call) {
+#ifdef LIMBOAI_MODULE
+			const int argument_count = cmd.args.size();
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * MAX(argument_count, 1));
+			for (int j = 0; j < argument_count; j++) {
+				argptrs[j] = &cmd.args[j];
+			}
+			Callable::CallError ce;
+			obj->callp(cmd.name, argptrs, argument_count, ce);
+			if (unlikely(ce.error != Callable::CallError::CALL_OK)) {
+				ERR_PRINT(vformat("LimboCommandBuffer: Error calling method \"%s\" on %s: %s.", cmd.name, obj, Variant::get_call_error_text(obj, cmd.name, argptrs, argument_count, ce)));
+			}
+#elif LIMBOAI_GDEXTENSION
+			// Call errors are not reported in GDExtension (see BTCallMethod).
+			obj->callv(cmd.name, cmd.args);
+#endif
+		} else {
+#ifdef LIMBOAI_MODULE
+			bool r_valid;
+			obj->set(cmd.name, cmd.value, &r_valid);
+			if (unlikely(!r_valid)) {
+				ERR_PRINT(vformat("LimboCommandBuffer: Couldn't set property \"%s\" with value \"%s\"", cmd.name, cmd.value));
+			}
+#elif LIMBOAI_GDEXTENSION
+			obj->set(cmd.name, cmd.value);
+#endif
+		}
+	}
+	commands.clear();
+}
@@ -0,0 +1,72 @@
+/**
+ * limbo_command_buffer.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_COMMAND_BUFFER_H
+#define LIMBO_COMMAND_BUFFER_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/object.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/array.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Records scene writes, so they can be applied later in one batch.
+// While a buffer is active on the current thread, built-in tasks and bound
+// blackboard variables record their writes into it instead of applying them.
+class LimboCommandBuffer {
+private:
+	struct Command {
+		uint64_t object_id = 0;
+		StringName name;
+		Variant value;
+		Array args;
+		bool is_call = false;
+	};
+
+	LocalVector<Command> commands;
+
+	static thread_local LimboCommandBuffer *active;
+
+public:
+	// Makes a buffer active on the current thread until the end of the scope. Null disables recording.
+	class Scope {
+		LimboCommandBuffer *prev_active;
+
+	public:
+		Scope(LimboCommandBuffer *p_buffer) {
+			prev_active = active;
+			active = p_buffer;
+		}
+		~Scope() { active = prev_active; }
+	};
+
+	_FORCE_INLINE_ static LimboCommandBuffer *get_active() { return active; }
+
+	void set_property(Object *p_object, const StringName &p_property, const Variant &p_value);
+	bool get_property(const Object *p_object, const StringName &p_property, Variant &r_value) const;
+	void call_method(Object *p_object, const StringName &p_method, const Array &p_args = Array());
+	bool get_last_call(const Object *p_object, const StringName &p_method, Array &r_args) const;
+
+	_FORCE_INLINE_ int get_command_count() const { return commands.size(); }
+	_FORCE_INLINE_ bool is_empty() const { return commands.is_empty(); }
+
+	void flush();
+	void clear() { commands.clear(); }
+};
+
+#endif // LIMBO_COMMAND_BUFFER_H
@@ -14,10 +14,13 @@
 LimboStringNames *LimboStringNames::singleton = nullptr;
 
 LimboStringNames::LimboStringNames() {
+	_enter = StringName("_enter");
+	_exit = StringName("_exit");
 	_generate_name = StringName("_generate_name");
 	_initialize_bt = StringName("_initialize_bt");
 	_param_type = StringName("_param_type");
 	_replace_task = StringName("_replace_task");
+	_tick = StringName("_tick");
 	_update_task_tree = StringName("_update_task_tree");
 	_weight_ = StringName("_weight_");
 	accent_color = StringName("accent_color");
@@ -102,10 +105,14 @@ LimboStringNames::LimboStringNames() {
 	NonFavorite = StringName("NonFavorite");
 	normal = StringName("normal");
 	panel = StringName("panel");
+	pause = StringName("pause");
+	physics_frame = StringName("physics_frame");
 	plan_changed = StringName("plan_changed");
+	play = StringName("play");
 	popup_hide = StringName("popup_hide");
 	pressed = StringName("pressed");
 	probability_clicked = StringName("probability_clicked");
+	process_frame = StringName("process_frame");
 	property_changed = StringName("property_changed");
 	ready = StringName("ready");
 	Reload = StringName("Reload");
@@ -128,6 +135,7 @@ LimboStringNames::LimboStringNames() {
 	setup = StringName("setup");
 	started = StringName("started");
 	StatusWarning = StringName("StatusWarning");
+	stop = StringName("stop");
 	stopped = StringName("stopped");
 	task_activated = StringName("task_activated");
 	task_button_pressed = StringName("task_button_pressed");
@@ -41,10 +41,13 @@ class LimboStringNames {
 public:
 	_FORCE_INLINE_ static LimboStringNames *get_singleton() { return singleton; }
 
+	StringName _enter;
+	StringName _exit;
 	StringName _generate_name;
 	StringName _initialize_bt;
 	StringName _param_type;
 	StringName _replace_task;
+	StringName _tick;
 	StringName _update_task_tree;
 	StringName _weight_;
 	StringName accent_color;
@@ -129,10 +132,14 @@ public:
 	StringName NonFavorite;
 	StringName normal;
 	StringName panel;
+	StringName pause;
+	StringName physics_frame;
 	StringName plan_changed;
+	StringName play;
 	StringName popup_hide;
 	StringName pressed;
 	StringName probability_clicked;
+	StringName process_frame;
 	StringName property_changed;
 	StringName ready;
 	StringName Reload;
@@ -155,6 +162,7 @@ public:
 	StringName setup;
 	StringName started;
 	StringName StatusWarning;
+	StringName stop;
 	StringName stopped;
 	StringName task_activated;
 	StringName task_button_pressed;
@@ -0,0 +1,69 @@
+/**
+ * limbo_task_profiler.cpp
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "limbo_task_profiler.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/os/time.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/time.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+thread_local LimboTaskProfiler *LimboTaskProfiler::active = nullptr;
+
+bool LimboTaskProfiler::_begin(const Object *p_task) {
+	HashMap<const Object *, uint32_t>::ConstIterator E = task_indices.find(p_task);
+	if (E == task_indices.end()) {
+		return false;
+	}
+	Frame frame;
+	frame.index = E->value;
+	frame.start_usec = Time::get_singleton()->get_ticks_usec();
+	stack.push_back(frame);
+	return true;
+}
+
+void LimboTaskProfiler::_end() {
+	const uint64_t end_usec = Time::get_singleton()->get_ticks_usec();
+	const Frame &frame = stack[stack.size() - 1];
+	const uint64_t elapsed_usec = end_usec - frame.start_usec;
+
+	Stats &s = stats[frame.index];
+	s.calls += 1;
+	s.inclusive_usec += elapsed_usec;
+	s.exclusive_usec += elapsed_usec > frame.children_usec ? elapsed_usec - frame.children_usec : 0;
+
+	stack.resize(stack.size() - 1);
+	if (!stack.is_empty()) {
+		stack[stack.size() - 1].children_usec += elapsed_usec;
+	}
+}
+
+void LimboTaskProfiler::add_task(const Object *p_task) {
+	ERR_FAIL_NULL(p_task);
+	ERR_FAIL_COND(task_indices.has(p_task));
+	task_indices.insert(p_task, stats.size());
+	stats.push_back(Stats());
+}
+
+void LimboTaskProfiler::clear() {
+	task_indices.clear();
+	stats.clear();
+	stack.clear();
+}
+
+void LimboTaskProfiler::reset_stats() {
+	for (Stats &s : stats) {
+		s = Stats();
+	}
+}
@@ -0,0 +1,101 @@
+/**
+ * limbo_task_profiler.h
+ * =============================================================================
+ * Copyright (c) 2023-present Serhii Snitsaruk and the LimboAI contributors.
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef LIMBO_TASK_PROFILER_H
+#define LIMBO_TASK_PROFILER_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/object.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+// Records call counts and execution time of tasks in a behavior tree instance.
+// While a profiler is active on the current thread, executed tasks report to it.
+// Inclusive time covers the whole execution of a task, and exclusive time leaves out its profiled children.
+class LimboTaskProfiler {
+public:
+	struct Stats {
+		uint64_t calls = 0;
+		uint64_t inclusive_usec = 0;
+		uint64_t exclusive_usec = 0;
+
+		_FORCE_INLINE_ void add(const Stats &p_other) {
+			calls += p_other.calls;
+			inclusive_usec += p_other.inclusive_usec;
+			exclusive_usec += p_other.exclusive_usec;
+		}
+	};
+
+private:
+	struct Frame {
+		uint32_t index = 0;
+		uint64_t start_usec = 0;
+		uint64_t children_usec = 0;
+	};
+
+	HashMap<const Object *, uint32_t> task_indices;
+	LocalVector<Stats> stats;
+	LocalVector<Frame> stack;
+
+	static thread_local LimboTaskProfiler *active;
+
+	bool _begin(const Object *p_task);
+	void _end();
+
+public:
+	// Makes a profiler active on the current thread until the end of the scope. Null disables profiling.
+	class Scope {
+		LimboTaskProfiler *prev_active;
+
+	public:
+		Scope(LimboTaskProfiler *p_profiler) {
+			prev_active = active;
+			active = p_profiler;
+		}
+		~Scope() { active = prev_active; }
+	};
+
+	// Measures a task until the end of the scope. Tasks unknown to the active profiler are not measured,
+	// so their time is counted towards the exclusive time of the closest profiled ancestor.
+	class Sample {
+		LimboTaskProfiler *profiler;
+
+	public:
+		_FORCE_INLINE_ Sample(const Object *p_task) {
+			profiler = (unlikely(active != nullptr) && active->_begin(p_task)) ? active : nullptr;
+		}
+		_FORCE_INLINE_ ~Sample() {
+			if (unlikely(profiler != nullptr)) {
+				profiler->_end();
+			}
+		}
+	};
+
+	_FORCE_INLINE_ static LimboTaskProfiler *get_active() { return active; }
+
+	// Tasks are identified by the index they were added at.
+	void add_task(const Object *p_task);
+	void clear();
+	void reset_stats();
+
+	_FORCE_INLINE_ int get_task_count() const { return stats.size(); }
+	_FORCE_INLINE_ const Stats &get_stats(int p_index) const { return stats[p_index]; }
+};
+
+#endif // LIMBO_TASK_PROFILER_H
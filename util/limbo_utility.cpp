@@ -200,6 +200,33 @@ bool LimboUtility::perform_check(CheckType p_check_type, const Variant &left_val
 	return ret;
 }
 
+// Fast path of perform_check() for floats, without Variant evaluation.
+bool LimboUtility::perform_check_float(CheckType p_check_type, double left_value, double right_value) const {
+	switch (p_check_type) {
+		case LimboUtility::CheckType::CHECK_EQUAL: {
+			return left_value == right_value;
+		}
+		case LimboUtility::CheckType::CHECK_LESS_THAN: {
+			return left_value < right_value;
+		}
+		case LimboUtility::CheckType::CHECK_LESS_THAN_OR_EQUAL: {
+			return left_value <= right_value;
+		}
+		case LimboUtility::CheckType::CHECK_GREATER_THAN: {
+			return left_value > right_value;
+		}
+		case LimboUtility::CheckType::CHECK_GREATER_THAN_OR_EQUAL: {
+			return left_value >= right_value;
+		}
+		case LimboUtility::CheckType::CHECK_NOT_EQUAL: {
+			return left_value != right_value;
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
 String LimboUtility::get_operation_string(Operation p_operation) const {
 	switch (p_operation) {
 		case OPERATION_NONE: {
@@ -291,6 +318,32 @@ Variant LimboUtility::perform_operation(Operation p_operation, const Variant &le
 	return ret;
 }
 
+// Fast path of perform_operation() for floats, without Variant evaluation.
+// Returns false if the operation isn't supported for floats, so the caller can fall back.
+bool LimboUtility::perform_operation_float(Operation p_operation, double left_value, double right_value, double &r_result) const {
+	switch (p_operation) {
+		case OPERATION_NONE: {
+			r_result = right_value;
+		} break;
+		case OPERATION_ADDITION: {
+			r_result = left_value + right_value;
+		} break;
+		case OPERATION_SUBTRACTION: {
+			r_result = left_value - right_value;
+		} break;
+		case OPERATION_MULTIPLICATION: {
+			r_result = left_value * right_value;
+		} break;
+		case OPERATION_DIVISION: {
+			r_result = left_value / right_value;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
 String LimboUtility::get_property_hint_text(PropertyHint p_hint) const {
 	switch (p_hint) {
 		case PROPERTY_HINT_NONE: {
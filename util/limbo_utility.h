@@ -79,9 +79,11 @@ public:
 
 	String get_check_operator_string(CheckType p_check_type) const;
 	bool perform_check(CheckType p_check_type, const Variant &left_value, const Variant &right_value);
+	bool perform_check_float(CheckType p_check_type, double left_value, double right_value) const;
 
 	String get_operation_string(Operation p_operation) const;
 	Variant perform_operation(Operation p_operation, const Variant &left_value, const Variant &right_value);
+	bool perform_operation_float(Operation p_operation, double left_value, double right_value, double &r_result) const;
 
 	String get_property_hint_text(PropertyHint p_hint) const;
 	PackedInt32Array get_property_hints_allowed_for_type(Variant::Type p_type) const;